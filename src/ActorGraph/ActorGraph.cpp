@@ -10,26 +10,280 @@
  */
 
 #include "ActorGraph.hpp"
+#include "MappedFile.hpp"
+#include <cstdint>
+#include <cctype>
+#include <climits>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
-#include <unordered_set>
 #include <queue>
 #include <stack>
 #include <utility>
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
 
 using namespace std;
 
+//a thread is only worth starting if it gets at least this much of the file
+static const size_t MIN_CHUNK_BYTES = 1 << 20;
+
+//a direction optimizing search sweeps bottom up once the frontier has more
+//than 1/BOTTOM_UP_EDGES of the unexplored edges, and goes back to top down
+//once it has fewer than 1/TOP_DOWN_NODES of the nodes on its side
+static const uint64_t BOTTOM_UP_EDGES = 14;
+static const uint64_t TOP_DOWN_NODES = 24;
+
+//a batch of breadth first searches goes through the multi source search
+//once it has this many queries from at least MULTI_SOURCE_WIDTH actors
+static const size_t MULTI_SOURCE_MIN_QUERIES = 1024;
+//the number of searches a multi source search runs at once, one per bit
+static const size_t MULTI_SOURCE_WIDTH = 64;
+//a level of a multi source search with more than 1/MULTI_SOURCE_DENSE of
+//the actors goes through every actor and movie instead of keeping lists of
+//the ones it reaches
+static const size_t MULTI_SOURCE_DENSE = 32;
+
+//the most buckets a bucket queue search will use, graphs with heavier
+//movies fall back to the binary heap
+static const uint32_t MAX_DIST_BUCKETS = 1 << 16;
+
+/* The title and year that together identify a movie while loading */
+struct MovieKey {
+    string_view title;
+    int year;
+    bool operator==( const MovieKey& other ) const {
+        return year == other.year && title == other.title;
+    }
+};
+
+/* Everything a loader thread parsed out of its part of the file. Ids are
+ * local to the chunk and are mapped to graph nodes when chunks are merged.
+ */
+struct LoadChunk {
+    //the lines this chunk covers
+    const char* begin;
+    const char* end;
+    //chunk local ids of every name seen in the chunk, an id is the index
+    //of the name in actorNames or movieKeys
+    FlatNameIndex actorIds;
+    FlatNameIndex movieIds;
+    vector<string_view> actorNames;
+    vector<MovieKey> movieKeys;
+    //every (actor, movie) credit of the chunk in file order
+    vector<pair<unsigned int, unsigned int>> credits;
+};
+
+/* Returns a pointer to the newline that ends the line starting at cur, or to
+ * fileEnd when the last line of the file has no newline.
+ * Parameter: cur - the first byte of the line
+ * Parameter: fileEnd - one past the last byte of the file
+ */
+static const char* findLineEnd( const char* cur, const char* fileEnd ) {
+    const void* newline = memchr( cur, '\n', fileEnd - cur );
+    return newline == 0 ? fileEnd : (const char*)newline;
+}
+
+/* Returns a pointer to the start of the line after the one ending at lineEnd
+ * Parameter: lineEnd - the newline (or file end) that ends the current line
+ * Parameter: fileEnd - one past the last byte of the file
+ */
+static const char* nextLine( const char* lineEnd, const char* fileEnd ) {
+    return lineEnd == fileEnd ? fileEnd : lineEnd + 1;
+}
+
+/* Splits a line into its tab seperated columns in place. The columns are
+ * counted the same way repeated getline calls with a tab delimiter count
+ * them, so a trailing tab does not start an extra empty column. Returns true
+ * only when the line has exactly three columns.
+ * Parameter: line - the first byte of the line
+ * Parameter: lineEnd - one past the last byte of the line
+ * Parameter: record - the array the three columns are written to
+ */
+static bool splitRecord( const char* line, const char* lineEnd,
+                         string_view* record ) {
+
+    unsigned int columns = 0;
+    const char* colStart = line;
+    while( colStart < lineEnd ) {
+        const void* tab = memchr( colStart, '\t', lineEnd - colStart );
+        const char* colEnd = tab == 0 ? lineEnd : (const char*)tab;
+        if( columns == 3 ) { return false; }
+        record[columns++] = string_view( colStart, colEnd - colStart );
+        if( colEnd == lineEnd ) { return columns == 3; }
+        colStart = colEnd + 1;
+    }
+    return columns == 3;
+
+}
+
+/* Parses the year column the way stoi does: leading whitespace and a sign
+ * are allowed and anything after the digits is ignored. Returns false if the
+ * column does not start with a number.
+ * Parameter: column - the text of the year column
+ * Parameter: year - where the parsed year is written
+ */
+static bool parseYear( string_view column, int& year ) {
+
+    size_t i = 0;
+    while( i < column.size() && isspace( (unsigned char)column[i] ) ) { i++; }
+    bool negative = false;
+    if( i < column.size() && (column[i] == '-' || column[i] == '+') ) {
+        negative = column[i] == '-';
+        i++;
+    }
+    if( i == column.size() || !isdigit( (unsigned char)column[i] ) ) {
+        return false;
+    }
+    long value = 0;
+    while( i < column.size() && isdigit( (unsigned char)column[i] ) ) {
+        value = value * 10 + (column[i] - '0');
+        if( value > INT_MAX ) { return false; }
+        i++;
+    }
+    year = negative ? (int)-value : (int)value;
+    return true;
+
+}
+
+/* Parses every line of a chunk into chunk local actor and movie tables.
+ * Names are kept as views into the mapped file and each credit is stored
+ * as a pair of chunk local ids, so no strings are copied here.
+ * Parameter: chunk - the chunk to parse, its begin and end must be set
+ */
+static void parseChunk( LoadChunk& chunk ) {
+
+    string_view record[3];
+    uint32_t actorId = 0;
+    uint32_t movieId = 0;
+    string_view lastActor = string_view();
+    MovieKey lastMovie = MovieKey();
+    bool first = true;
+
+    const char* cur = chunk.begin;
+    while( cur < chunk.end ) {
+
+        const char* lineEnd = findLineEnd( cur, chunk.end );
+        bool isRecord = splitRecord( cur, lineEnd, record );
+        cur = nextLine( lineEnd, chunk.end );
+
+        int year;
+        if( !isRecord || !parseYear( record[2], year ) ) { continue; }
+
+        if( first || record[0] != lastActor ) {
+            uint32_t hash = FlatNameIndex::hash( record[0] );
+            actorId = chunk.actorIds.find( hash, [&]( uint32_t id ) {
+                return chunk.actorNames[id] == record[0];
+            } );
+            if( actorId == FlatNameIndex::NOT_FOUND ) {
+                actorId = chunk.actorNames.size();
+                chunk.actorIds.insert( hash, actorId );
+                chunk.actorNames.push_back( record[0] );
+            }
+            lastActor = record[0];
+        }
+
+        MovieKey movie = { record[1], year };
+        if( first || !(movie == lastMovie) ) {
+            uint32_t hash = FlatNameIndex::hash( record[1], year );
+            movieId = chunk.movieIds.find( hash, [&]( uint32_t id ) {
+                return chunk.movieKeys[id] == movie;
+            } );
+            if( movieId == FlatNameIndex::NOT_FOUND ) {
+                movieId = chunk.movieKeys.size();
+                chunk.movieIds.insert( hash, movieId );
+                chunk.movieKeys.push_back( movie );
+            }
+            lastMovie = movie;
+        }
+
+        first = false;
+        chunk.credits.push_back(
+            std::pair<unsigned int, unsigned int>( actorId, movieId ) );
+
+    }
+
+}
+
 /**
  * Constructor of the Actor graph
  */ 
 ActorGraph::ActorGraph(void) {
-    actorMap = std::unordered_map<string, ActorNode*>();
-    movieMap = std::unordered_map<string, MovieNode*>();
+    actorIndex = FlatNameIndex();
+    movieIndex = FlatNameIndex();
+    actorNames = std::vector<string_view>();
+    actorList = std::vector<ActorNode*>();
+    movieList = std::vector<MovieNode*>();
+    touchedMovies = std::vector<uint32_t>();
+}
+
+/**
+ * Finds the actor with the given name in actorIndex, which both a graph
+ * loaded from a file and one loaded from a snapshot have. Returns 0 if
+ * there is no actor with that name.
+ * Parameter: name - the name of the actor to find
+ */
+ActorNode* ActorGraph::findActor( string_view name ) const {
+
+    uint32_t id = actorIndex.find( FlatNameIndex::hash( name ),
+        [&]( uint32_t actor ) { return actorNames[actor] == name; } );
+    return id == FlatNameIndex::NOT_FOUND ? 0 : actorList[id];
+
+}
+
+/**
+ * Finds the actor with the given name in the graph or creates a new one
+ * if this is the first time the actor was seen. The name is looked up as
+ * it is and only copied into the name pool for a new actor.
+ * Parameter: name - the name of the actor
+ */
+ActorNode* ActorGraph::findOrAddActor( string_view name ) {
+
+    uint32_t hash = FlatNameIndex::hash( name );
+    uint32_t id = actorIndex.find( hash,
+        [&]( uint32_t actor ) { return actorNames[actor] == name; } );
+    if( id != FlatNameIndex::NOT_FOUND ) { return actorList[id]; }
+
+    ActorNode* actorNode = actorArena.create( namePool.add( name ),
+                                              actorList.size() );
+    actorIndex.insert( hash, actorNode->id );
+    actorList.push_back( actorNode );
+    actorNames.push_back( actorNode->name );
+    return actorNode;
+
+}
+
+/**
+ * Finds the movie with the given title and year in the graph or creates a
+ * new one if this is the first time the movie was seen. Like an actor's
+ * name the title is only copied into the name pool for a new movie.
+ * Parameter: title - the title of the movie
+ * Parameter: year - the year the movie came out
+ */
+MovieNode* ActorGraph::findOrAddMovie( string_view title, int year ) {
+
+    uint32_t hash = FlatNameIndex::hash( title, year );
+    uint32_t id = movieIndex.find( hash, [&]( uint32_t movie ) {
+        return movieList[movie]->year == (unsigned int)year &&
+               movieList[movie]->name == title;
+    } );
+    if( id != FlatNameIndex::NOT_FOUND ) { return movieList[id]; }
+
+    MovieNode* movieNode = movieArena.create( namePool.add( title ), year,
+                                              movieList.size() );
+    movieIndex.insert( hash, movieNode->id );
+    movieList.push_back( movieNode );
+    return movieNode;
+
 }
 
 /** 
@@ -37,81 +291,765 @@ ActorGraph::ActorGraph(void) {
  * list of an actor, a movie they played in, and the year of the movie and
  * builds either a weighted or unweighted graph based on the info. The
  * weight of the movie is how old the movie is which is 2020-year.
+ * The file is memory mapped and each line is split in place, so only
+ * the names of new actors and movies are ever copied out of it. Large
+ * files are split at line boundaries and parsed by several threads, then
+ * merged in file order so the graph is the same as a single thread load.
  * Parameter: in_filename - the name of the file containing the info
- * Parameter: use_weighted_edges - whether the graph is weighted or not
+ * Parameter: numThreads - the most threads to parse with, 0 for all cores
+ */
+bool ActorGraph::loadFromFile(const char* in_filename,
+                              unsigned int numThreads) {
+
+    //a snapshot does not keep the movie index that adding credits needs,
+    //so it is built from the movies the first time credits are added
+    if( movieIndex.size() != movieList.size() ) {
+        movieIndex.clear();
+        movieIndex.reserve( movieList.size() );
+        for( uint32_t i = 0; i < movieList.size(); i++ ) {
+            movieIndex.insert( FlatNameIndex::hash( movieList[i]->name,
+                                                    movieList[i]->year ),
+                               i );
+        }
+    }
+
+    //map the whole file into memory instead of streaming it line by line
+    MappedFile infile( in_filename );
+    if( !infile.isOpen() ) {
+        cerr << "Failed to read " << in_filename << "!\n";
+        return false;
+    }
+
+    const char* cur = infile.data();
+    const char* fileEnd = cur + infile.size();
+
+    //skip the header
+    cur = nextLine( findLineEnd( cur, fileEnd ), fileEnd );
+
+    //only split the file if every thread gets a decent amount of it
+    if( numThreads == 0 ) { numThreads = thread::hardware_concurrency(); }
+    size_t maxThreads = (size_t)(fileEnd - cur) / MIN_CHUNK_BYTES;
+    if( numThreads > maxThreads ) { numThreads = (unsigned int)maxThreads; }
+
+    //every (actor id, movie id) credit of the file in file order
+    vector<pair<uint32_t, uint32_t>> credits =
+        std::vector<pair<uint32_t, uint32_t>>();
+    if( numThreads > 1 ) {
+        loadChunks( cur, fileEnd, numThreads, credits );
+    } else {
+        loadLines( cur, fileEnd, credits );
+    }
+
+    //remember the movies that got credits for updateSpanningForest
+    size_t firstTouched = touchedMovies.size();
+    for( size_t i = 0; i < credits.size(); i++ ) {
+        touchedMovies.push_back( credits[i].second );
+    }
+    std::sort( touchedMovies.begin() + firstTouched, touchedMovies.end() );
+    touchedMovies.erase( std::unique( touchedMovies.begin() + firstTouched,
+                                      touchedMovies.end() ),
+                         touchedMovies.end() );
+
+    //lay the credits out as flat adjacency arrays after the existing ones
+    vector<uint32_t> weights = std::vector<uint32_t>( movieList.size() );
+    for( unsigned int i = 0; i < movieList.size(); i++ ) {
+        weights[i] = movieList[i]->weight;
+    }
+    csr.append( actorList.size(), weights, credits );
+
+    return true;
+}
+
+/**
+ * Parses the lines between begin and fileEnd on the calling thread and
+ * adds the actor and movie id of every credit to credits in file order.
+ * Parameter: cur - the first line after the header
+ * Parameter: fileEnd - one past the last byte of the file
+ * Parameter: credits - the list the credits are added to
  */
-bool ActorGraph::loadFromFile(const char* in_filename) {
+void ActorGraph::loadLines( const char* cur, const char* fileEnd,
+                            vector<pair<uint32_t, uint32_t>>& credits ) {
 
-    // Initialize the file stream
-    ifstream infile(in_filename);
+    string_view record[3];
 
-    bool have_header = false;
+    //credits are grouped by movie or by actor in the database, so remember
+    //the nodes of the previous line to skip most of the map lookups
+    ActorNode* actorNode = 0;
+    MovieNode* movieNode = 0;
+    string_view lastActor = string_view();
+    string_view lastMovie = string_view();
+    int lastYear = 0;
 
     // keep reading lines until the end of file is reached
-    while (infile) {
-        string s;
+    while( cur < fileEnd ) {
 
-        // get the next line
-        if (!getline(infile, s)) break;
+        const char* lineEnd = findLineEnd( cur, fileEnd );
+        bool isRecord = splitRecord( cur, lineEnd, record );
+        cur = nextLine( lineEnd, fileEnd );
 
-        if (!have_header) {
-            // skip the header
-            have_header = true;
+        int year;
+        if( !isRecord || !parseYear( record[2], year ) ) {
+            // we should have exactly 3 columns
             continue;
         }
 
-        istringstream ss(s);
-        vector<string> record;
+        //find the actor and the movie in the map or create them
+        if( actorNode == 0 || record[0] != lastActor ) {
+            actorNode = findOrAddActor( record[0] );
+            lastActor = record[0];
+        }
+        if( movieNode == 0 || year != lastYear || record[1] != lastMovie ) {
+            movieNode = findOrAddMovie( record[1], year );
+            lastMovie = record[1];
+            lastYear = year;
+        }
+
+        //connect the movie with the actor
+        credits.push_back(
+            std::pair<uint32_t, uint32_t>( actorNode->id, movieNode->id ) );
 
-        while (ss) {
-            string str;
+    }
 
-            // get the next string before hitting a tab character and put it in 'str'
-            if (!getline(ss, str, '\t')) break;
-            record.push_back(str);
+}
+
+/**
+ * Splits the lines between begin and fileEnd into numThreads chunks that
+ * end on a newline, parses every chunk on its own thread and then merges
+ * the chunks into the graph in file order. Every thread only deduplicates
+ * the names in its own chunk, so the merge does one map lookup per distinct
+ * name in a chunk instead of one per line.
+ * Parameter: begin - the first line after the header
+ * Parameter: fileEnd - one past the last byte of the file
+ * Parameter: numThreads - the number of chunks to split the file into
+ * Parameter: credits - the list the credits are added to
+ */
+void ActorGraph::loadChunks( const char* begin, const char* fileEnd,
+                             unsigned int numThreads,
+                             vector<pair<uint32_t, uint32_t>>& credits ) {
+
+    //cut the file into equal parts and move each cut to the next newline
+    vector<LoadChunk> chunks = std::vector<LoadChunk>( numThreads );
+    size_t chunkSize = (size_t)(fileEnd - begin) / numThreads;
+    const char* chunkStart = begin;
+    for( unsigned int i = 0; i < numThreads; i++ ) {
+        const char* chunkEnd = fileEnd;
+        if( i + 1 < numThreads && chunkStart + chunkSize < fileEnd ) {
+            chunkEnd = nextLine( findLineEnd( chunkStart + chunkSize,
+                                              fileEnd ), fileEnd );
         }
+        chunks[i].begin = chunkStart;
+        chunks[i].end = chunkEnd;
+        chunkStart = chunkEnd;
+    }
 
-        if (record.size() != 3) {
-            // we should have exactly 3 columns
-            continue;
+    //parse all of the chunks at once
+    vector<thread> workers = std::vector<thread>();
+    for( unsigned int i = 1; i < numThreads; i++ ) {
+        workers.emplace_back( parseChunk, std::ref(chunks[i]) );
+    }
+    parseChunk( chunks[0] );
+    for( unsigned int i = 0; i < workers.size(); i++ ) {
+        workers[i].join();
+    }
+
+    //merge each chunk in order so every adjacency list stays in file order
+    vector<uint32_t> actorIds = std::vector<uint32_t>();
+    vector<uint32_t> movieIds = std::vector<uint32_t>();
+    for( unsigned int i = 0; i < chunks.size(); i++ ) {
+
+        LoadChunk& chunk = chunks[i];
+        actorIds.resize( chunk.actorNames.size() );
+        for( unsigned int j = 0; j < chunk.actorNames.size(); j++ ) {
+            actorIds[j] = findOrAddActor( chunk.actorNames[j] )->id;
+        }
+        movieIds.resize( chunk.movieKeys.size() );
+        for( unsigned int j = 0; j < chunk.movieKeys.size(); j++ ) {
+            movieIds[j] = findOrAddMovie( chunk.movieKeys[j].title,
+                                          chunk.movieKeys[j].year )->id;
         }
 
-        string actor(record[0]);
-        string movie_title(record[1]);
-        int year = stoi(record[2]);
-        
-        //find the actor and the movie in the map or create them
-        ActorNode* actorNode;
-        if( actorMap.find( actor ) == actorMap.end() ) {
-            actorNode = new ActorNode( actor );
-            actorMap.insert( std::pair<string,ActorNode*>(actor, actorNode) );
+        for( unsigned int j = 0; j < chunk.credits.size(); j++ ) {
+            credits.push_back( std::pair<uint32_t, uint32_t>(
+                actorIds[chunk.credits[j].first],
+                movieIds[chunk.credits[j].second] ) );
+        }
+
+        //free the chunk's tables as soon as they are merged
+        chunk = LoadChunk();
+
+    }
+
+}
+
+/* Returns "(actor)", the start of every formatted path
+ * Parameter: actorName - the name of the actor the path starts at
+ */
+static string pathStart( string_view actorName ) {
+    string outStr = "(";
+    outStr += actorName;
+    outStr += ')';
+    return outStr;
+}
+
+/* Adds "--[movie#@year]-->(actor)", one step of a formatted path, to the
+ * end of outStr
+ * Parameter: outStr - the path so far
+ * Parameter: movie - the movie the step goes through
+ * Parameter: actorName - the name of the actor the step goes to
+ */
+static void appendStep( string& outStr, const MovieNode* movie,
+                        string_view actorName ) {
+    outStr += "--[";
+    outStr += movie->name;
+    outStr += "#@";
+    outStr += to_string( movie->year );
+    outStr += "]-->(";
+    outStr += actorName;
+    outStr += ')';
+}
+
+/**
+ * This method builds the formatted path string for a search that reached
+ * actorEnd, by following the previous movie of each actor and the previous
+ * actor of each movie back to the starting actor.
+ * Parameter: actorEnd - the id of the actor the search ended at
+ * Parameter: context - the context of the search that found actorEnd
+ */
+string ActorGraph::formatPath( uint32_t actorEnd,
+                               const QueryContext& context ) const {
+
+    //backtrack to the start node and add each actor and movie to a stack
+    stack<pair<uint32_t,uint32_t>> actorOrder = 
+        std::stack<std::pair<uint32_t,uint32_t>>();
+    uint32_t curActor = actorEnd;
+    while( context.actorPrevious[curActor] != NO_ID ) {
+    
+        uint32_t movieEdge = context.actorPrevious[curActor];
+        //add the node and edge to a pair and to the stack
+        actorOrder.push( std::pair<uint32_t,uint32_t>( curActor, movieEdge ) );
+        curActor = context.moviePrevious[movieEdge];
+
+    }
+    
+    //start with the curNode which should be the starting actor
+    string outStr = pathStart( actorList[curActor]->name );
+    //go through each pair in the stack and add it to the string
+    while( !actorOrder.empty() ) {
+
+        appendStep( outStr, movieList[actorOrder.top().second],
+                    actorList[actorOrder.top().first]->name );
+        actorOrder.pop();
+
+    }
+
+    return outStr;
+
+}
+
+/**
+ * This method marks every target of a search in the context. Returns the
+ * number of different actors in the targets.
+ * Parameter: targets - the targets of the search sorted by actor id
+ * Parameter: context - the search state, already begun
+ */
+size_t ActorGraph::markTargets( const vector<PathTarget>& targets,
+                                QueryContext& context ) const {
+
+    size_t numActors = 0;
+    for( size_t i = 0; i < targets.size(); i++ ) {
+        if( i > 0 && targets[i].actor == targets[i - 1].actor ) { continue; }
+        context.markTarget( targets[i].actor );
+        numActors++;
+    }
+    return numActors;
+
+}
+
+/**
+ * This method builds the path to an actor a search just reached and gives
+ * it to every target that ends at that actor.
+ * Parameter: curActor - the id of the target actor that was reached
+ * Parameter: targets - the targets of the search sorted by actor id
+ * Parameter: results - where the path of each target is written
+ * Parameter: context - the search state that reached curActor
+ */
+void ActorGraph::settleTarget( uint32_t curActor,
+                               const vector<PathTarget>& targets,
+                               vector<string>& results,
+                               QueryContext& context ) const {
+
+    string path = formatPath( curActor, context );
+    vector<PathTarget>::const_iterator target = std::lower_bound(
+        targets.begin(), targets.end(), curActor,
+        []( const PathTarget& t, uint32_t actor ) { return t.actor < actor; } );
+    for( ; target != targets.end() && target->actor == curActor; target++ ) {
+        results[target->index] = path;
+    }
+    context.unmarkTarget( curActor );
+
+}
+
+/**
+ * This method answers a whole batch of path queries. Queries that start at
+ * the same actor are answered together by one search that runs until all
+ * of their end actors are reached, instead of one search per query. The
+ * results are in the same order as the queries and each one is the same
+ * string the single query method of the search would return, except that
+ * a batch of at least 1024 breadth first queries from 64 or more actors
+ * goes through the multi source search, which picks its own path when
+ * there are several shortest ones.
+ * Parameter: queries - the starting and ending actor of every query
+ * Parameter: search - the search that answers the queries
+ */
+vector<string> ActorGraph::findPaths(
+    const vector<pair<string, string>>& queries, PathSearch search ) {
+    return findPaths( queries, search, defaultContext );
+}
+
+/**
+ * This method is findPaths with all of the search state kept in the given
+ * context instead of the graph.
+ * Parameter: queries - the starting and ending actor of every query
+ * Parameter: search - the search that answers the queries
+ * Parameter: context - the search state, one per thread searching
+ */
+vector<string> ActorGraph::findPaths(
+    const vector<pair<string, string>>& queries, PathSearch search,
+    QueryContext& context ) const {
+
+    vector<string> results = std::vector<string>( queries.size() );
+    vector<pair<uint32_t, PathTarget>> sorted =
+        std::vector<pair<uint32_t, PathTarget>>();
+    vector<size_t> groups = std::vector<size_t>();
+    groupQueries( queries, search, sorted, groups );
+
+    vector<PathTarget> targets = std::vector<PathTarget>();
+    for( size_t i = 0; i + 1 < groups.size(); i++ ) {
+        runGroup( queries, search, sorted, groups[i], groups[i + 1], targets,
+                  results, context );
+    }
+    return results;
+
+}
+
+/**
+ * This method is findPaths with the searches spread over several threads.
+ * Every thread has its own context and takes the next search that has not
+ * been started yet until there are none left, and since each search writes
+ * its results to the places of its own queries the results are in the same
+ * order as with one thread.
+ * Parameter: queries - the starting and ending actor of every query
+ * Parameter: search - the search that answers the queries
+ * Parameter: numThreads - the number of threads to search with, 0 for all
+ *                         cores
+ */
+vector<string> ActorGraph::findPaths(
+    const vector<pair<string, string>>& queries, PathSearch search,
+    unsigned int numThreads ) const {
+
+    vector<string> results = std::vector<string>( queries.size() );
+    vector<pair<uint32_t, PathTarget>> sorted =
+        std::vector<pair<uint32_t, PathTarget>>();
+    vector<size_t> groups = std::vector<size_t>();
+    groupQueries( queries, search, sorted, groups );
+
+    //there is no point in more threads than searches
+    if( numThreads == 0 ) { numThreads = thread::hardware_concurrency(); }
+    if( numThreads > groups.size() - 1 ) {
+        numThreads = (unsigned int)(groups.size() - 1);
+    }
+    if( numThreads == 0 ) { numThreads = 1; }
+
+    atomic<size_t> nextGroup( 0 );
+    auto worker = [&]() {
+        QueryContext context = QueryContext();
+        vector<PathTarget> targets = std::vector<PathTarget>();
+        for( size_t i = nextGroup++; i + 1 < groups.size(); i = nextGroup++ ) {
+            runGroup( queries, search, sorted, groups[i], groups[i + 1],
+                      targets, results, context );
+        }
+    };
+    vector<thread> workers = std::vector<thread>();
+    for( unsigned int i = 1; i < numThreads; i++ ) {
+        workers.emplace_back( worker );
+    }
+    worker();
+    for( unsigned int i = 0; i < workers.size(); i++ ) {
+        workers[i].join();
+    }
+    return results;
+
+}
+
+/**
+ * This method sorts a batch of queries into the searches that answer them.
+ * Queries are sorted by starting actor and then by ending actor, and every
+ * starting actor is one search, except for bidirectional searches where
+ * every query is its own search and multi source searches where every 64
+ * starting actors are one search. A big enough batch of breadth first
+ * searches is switched to the multi source search. Queries with an actor
+ * that is not in the graph are left out, so their results stay empty.
+ * Parameter: queries - the starting and ending actor of every query
+ * Parameter: search - the search that answers the queries, changed to
+ *                     SEARCH_MULTI_SOURCE if the batch is switched to it
+ * Parameter: sorted - filled with the starting actor and target of every
+ *                     query that has both actors in the graph
+ * Parameter: groups - filled with where each search's queries start in
+ *                     sorted, followed by the size of sorted
+ */
+void ActorGraph::groupQueries( const vector<pair<string, string>>& queries,
+                               PathSearch& search,
+                               vector<pair<uint32_t, PathTarget>>& sorted,
+                               vector<size_t>& groups ) const {
+
+    for( size_t i = 0; i < queries.size(); i++ ) {
+        ActorNode* startNode = findActor( queries[i].first );
+        ActorNode* endNode = findActor( queries[i].second );
+        if( startNode == 0 || endNode == 0 ) { continue; }
+        sorted.push_back( pair<uint32_t, PathTarget>(
+            startNode->id, PathTarget{ endNode->id, i } ) );
+    }
+
+    //a bidirectional search is tied to both of its actors
+    if( search == SEARCH_BIDIRECTIONAL ||
+        search == SEARCH_WEIGHTED_BIDIRECTIONAL ) {
+        for( size_t i = 0; i <= sorted.size(); i++ ) { groups.push_back( i ); }
+        return;
+    }
+
+    std::sort( sorted.begin(), sorted.end(),
+        []( const pair<uint32_t, PathTarget>& q1,
+            const pair<uint32_t, PathTarget>& q2 ) {
+            if( q1.first != q2.first ) { return q1.first < q2.first; }
+            return q1.second.actor < q2.second.actor;
+        } );
+    for( size_t i = 0; i < sorted.size(); i++ ) {
+        if( i == 0 || sorted[i].first != sorted[i - 1].first ) {
+            groups.push_back( i );
+        }
+    }
+
+    //large unweighted batches run their searches 64 at a time, so only
+    //every 64th starting actor begins a group
+    if( search == SEARCH_BFS && sorted.size() >= MULTI_SOURCE_MIN_QUERIES &&
+        groups.size() >= MULTI_SOURCE_WIDTH ) {
+        search = SEARCH_MULTI_SOURCE;
+    }
+    if( search == SEARCH_MULTI_SOURCE ) {
+        size_t numGroups = 0;
+        for( size_t i = 0; i < groups.size(); i += MULTI_SOURCE_WIDTH ) {
+            groups[numGroups++] = groups[i];
+        }
+        groups.resize( numGroups );
+    }
+    groups.push_back( sorted.size() );
+
+}
+
+/**
+ * This method runs the search that answers one group of queries sorted by
+ * groupQueries.
+ * Parameter: queries - the starting and ending actor of every query
+ * Parameter: search - the search that answers the queries
+ * Parameter: sorted - the queries sorted by groupQueries
+ * Parameter: begin - where the group starts in sorted
+ * Parameter: end - where the group ends in sorted
+ * Parameter: targets - a list to hold the group's targets in
+ * Parameter: results - where the path of each query is written
+ * Parameter: context - the search state, one per thread searching
+ */
+void ActorGraph::runGroup( const vector<pair<string, string>>& queries,
+                           PathSearch search,
+                           const vector<pair<uint32_t, PathTarget>>& sorted,
+                           size_t begin, size_t end,
+                           vector<PathTarget>& targets,
+                           vector<string>& results,
+                           QueryContext& context ) const {
+
+    if( search == SEARCH_BIDIRECTIONAL ) {
+        size_t index = sorted[begin].second.index;
+        results[index] = findClosestActorsBidirectional(
+            queries[index].first, queries[index].second, context );
+        return;
+    }
+    if( search == SEARCH_WEIGHTED_BIDIRECTIONAL ) {
+        size_t index = sorted[begin].second.index;
+        results[index] = findWeightedActorsBidirectional(
+            queries[index].first, queries[index].second, context );
+        return;
+    }
+    if( search == SEARCH_MULTI_SOURCE ) {
+        multiSourceFrom( sorted, begin, end, results, context );
+        return;
+    }
+
+    uint32_t startActor = sorted[begin].first;
+    targets.clear();
+    for( size_t i = begin; i < end; i++ ) {
+        targets.push_back( sorted[i].second );
+    }
+
+    if( search == SEARCH_BFS ) {
+        closestFrom( startActor, targets, results, context );
+    } else if( search == SEARCH_DIJKSTRA ) {
+        weightedFrom( startActor, targets, results, context );
+    } else if( search == SEARCH_ALT ) {
+        //an A* search only heads towards one actor at a time
+        for( size_t i = 0; i < targets.size(); i++ ) {
+            results[targets[i].index] = weightedPathALT(
+                startActor, targets[i].actor, context );
+        }
+    } else if( search == SEARCH_HIERARCHY ) {
+        for( size_t i = 0; i < targets.size(); i++ ) {
+            results[targets[i].index] = weightedPathCH(
+                startActor, targets[i].actor, context );
+        }
+    } else {
+        weightedFromDial( startActor, targets, results, context );
+    }
+
+}
+
+/**
+ * Adds every id with a mask to a list in order of id, for a level of a
+ * multi source search that reached too much to list as it went.
+ * Parameter: ids - the list the ids are added to
+ * Parameter: masks - the mask of every id, set for the ones reached
+ * Parameter: numIds - the number of ids
+ */
+static void addReached( vector<uint32_t>& ids,
+                        const vector<uint64_t>& masks, uint32_t numIds ) {
+    for( uint32_t id = 0; id < numIds; id++ ) {
+        if( masks[id] != 0 ) { ids.push_back( id ); }
+    }
+}
+
+/**
+ * This method answers the queries of up to 64 starting actors with one
+ * multi source breadth first search. Every starting actor gets a bit, and
+ * every actor and movie has a mask of the searches that have reached it, so
+ * each level looks at the edges of a node once for all of the searches
+ * whose frontier it is in. Only the actors that get a new bit on a level
+ * are kept for it, with the bits they got, which is enough to build the
+ * paths and is all the next level has to go through. A search's bit is
+ * dropped from the frontier once all of its targets have been found.
+ * Parameter: sorted - the queries sorted by groupQueries
+ * Parameter: begin - where the searches' queries start in sorted
+ * Parameter: end - where the searches' queries end in sorted
+ * Parameter: results - where the path of each query is written
+ * Parameter: context - the search state, one per thread searching
+ */
+void ActorGraph::multiSourceFrom(
+    const vector<pair<uint32_t, PathTarget>>& sorted, size_t begin,
+    size_t end, vector<string>& results, QueryContext& context ) const {
+
+    context.beginMultiSource( csr.numActors(), csr.numMovies() );
+    vector<uint64_t>& actorSeen = context.actorSearches;
+    vector<uint64_t>& actorNext = context.actorSearchesNext;
+    vector<uint64_t>& movieSeen = context.movieSearches;
+    vector<uint64_t>& movieFrontier = context.movieSearchesNext;
+    vector<uint32_t>& levelActors = context.levelActors;
+    vector<uint64_t>& levelMasks = context.levelMasks;
+    vector<size_t>& levelStarts = context.levelStarts;
+    vector<uint32_t>& actorEntries = context.actorEntries;
+    vector<uint32_t>& earlierEntries = context.earlierEntries;
+    vector<uint32_t>& reachedMovies = context.reachedMovies;
+
+    //give every starting actor a bit, the queries are grouped by start
+    vector<pair<uint64_t, PathTarget>> pending =
+        std::vector<pair<uint64_t, PathTarget>>();
+    uint64_t bit = 0;
+    levelStarts.push_back( 0 );
+    for( size_t i = begin; i < end; i++ ) {
+        if( i == begin || sorted[i].first != sorted[i - 1].first ) {
+            bit = bit == 0 ? 1 : bit << 1;
+            actorSeen[sorted[i].first] |= bit;
+            actorEntries[sorted[i].first] = levelActors.size();
+            levelActors.push_back( sorted[i].first );
+            levelMasks.push_back( bit );
+            earlierEntries.push_back( NO_ID );
+        }
+        pending.push_back( pair<uint64_t, PathTarget>( bit,
+                                                       sorted[i].second ) );
+    }
+    levelStarts.push_back( levelActors.size() );
+
+    for( unsigned int level = 0; !pending.empty(); level++ ) {
+
+        //answer every query whose end was reached at this level and keep
+        //the bits of the searches that still have queries, a query is
+        //answered on the first level its end is reached
+        uint64_t active = 0;
+        for( size_t i = 0; i < pending.size(); ) {
+            const PathTarget& target = pending[i].second;
+            if( actorSeen[target.actor] & pending[i].first ) {
+                results[target.index] = formatMultiSourcePath(
+                    target.actor, pending[i].first, level, context );
+                pending[i] = pending.back();
+                pending.pop_back();
+                continue;
+            }
+            active |= pending[i].first;
+            i++;
+        }
+        if( active == 0 ) { break; }
+
+        //a big frontier goes through every movie in order of id, a small
+        //one lists the ones it reaches and sorts them
+        bool dense = levelStarts[level + 1] - levelStarts[level] >
+                     csr.numActors() / MULTI_SOURCE_DENSE;
+
+        //every actor in a frontier reaches the movies it is in
+        size_t firstMovie = reachedMovies.size();
+        for( size_t i = levelStarts[level]; i < levelStarts[level + 1];
+             i++ ) {
+            uint64_t searches = levelMasks[i] & active;
+            if( searches == 0 ) { continue; }
+            uint32_t actor = levelActors[i];
+            const uint32_t* movieEnd = csr.moviesEnd( actor );
+            const uint32_t* movie = csr.moviesBegin( actor );
+            if( dense ) {
+                for( ; movie != movieEnd; movie++ ) {
+                    movieFrontier[*movie] |= searches & ~movieSeen[*movie];
+                }
+                continue;
+            }
+            for( ; movie != movieEnd; movie++ ) {
+                uint64_t fresh = searches & ~movieSeen[*movie];
+                if( fresh != 0 && movieFrontier[*movie] == 0 ) {
+                    reachedMovies.push_back( *movie );
+                }
+                movieFrontier[*movie] |= fresh;
+            }
+        }
+
+        //and every movie in a frontier reaches the actors in it, in order of
+        //id so the cast lists are read front to back
+        if( dense ) {
+            addReached( reachedMovies, movieFrontier, csr.numMovies() );
         } else {
-            actorNode = actorMap.find( actor )->second;
+            std::sort( reachedMovies.begin() + firstMovie,
+                       reachedMovies.end() );
+        }
+        //and the same goes for the actors of a lot of movies
+        dense = reachedMovies.size() - firstMovie >
+                csr.numMovies() / MULTI_SOURCE_DENSE;
+        for( size_t i = firstMovie; i < reachedMovies.size(); i++ ) {
+            uint32_t movie = reachedMovies[i];
+            uint64_t searches = movieFrontier[movie];
+            movieSeen[movie] |= searches;
+            movieFrontier[movie] = 0;
+            const uint32_t* actorEnd = csr.actorsEnd( movie );
+            const uint32_t* actor = csr.actorsBegin( movie );
+            if( dense ) {
+                for( ; actor != actorEnd; actor++ ) {
+                    actorNext[*actor] |= searches & ~actorSeen[*actor];
+                }
+                continue;
+            }
+            for( ; actor != actorEnd; actor++ ) {
+                uint64_t fresh = searches & ~actorSeen[*actor];
+                if( fresh != 0 && actorNext[*actor] == 0 ) {
+                    levelActors.push_back( *actor );
+                }
+                actorNext[*actor] |= fresh;
+            }
         }
-        
-        MovieNode* movieNode;
-        string movieString = movie_title + '\t' + to_string(year);
-        if( movieMap.find( movieString) == movieMap.end() ) {
-            movieNode = new MovieNode( movie_title, year );
-            movieMap.insert( 
-                std::pair<string,MovieNode*>(movieString, movieNode) );
 
+        //the next level is kept in order of id too, and every actor on it
+        //is linked to its entry on an earlier level for the paths
+        size_t firstActor = levelStarts[level + 1];
+        if( dense ) {
+            addReached( levelActors, actorNext, csr.numActors() );
         } else {
-            movieNode = movieMap.find(movieString)->second;
+            std::sort( levelActors.begin() + firstActor, levelActors.end() );
+        }
+        for( size_t i = firstActor; i < levelActors.size(); i++ ) {
+            uint32_t actor = levelActors[i];
+            earlierEntries.push_back( actorEntries[actor] );
+            actorEntries[actor] = i;
+            levelMasks.push_back( actorNext[actor] );
+            actorSeen[actor] |= actorNext[actor];
+            actorNext[actor] = 0;
         }
+        levelStarts.push_back( levelActors.size() );
+        //the searches that are left cannot reach anything else
+        if( levelStarts[level + 2] == levelStarts[level + 1] ) { break; }
 
-        //connect the movie with the actor
-        actorNode->movies.push_back( movieNode );
-        movieNode->actors.push_back( actorNode );
+    }
 
+    //clear the masks for the next search with this context
+    for( size_t i = 0; i < levelActors.size(); i++ ) {
+        actorSeen[levelActors[i]] = 0;
+        actorEntries[levelActors[i]] = NO_ID;
     }
-    if (!infile.eof()) {
-        cerr << "Failed to read " << in_filename << "!\n";
-        return false;
+    for( size_t i = 0; i < reachedMovies.size(); i++ ) {
+        movieSeen[reachedMovies[i]] = 0;
     }
-    infile.close();
 
-    return true;
+}
+
+/**
+ * This method builds the formatted path from the start of one of the
+ * searches of a multi source search to actorEnd. Going back one level at a
+ * time, it takes the first movie of the current actor that has an actor the
+ * search reached on the level before.
+ * Parameter: actorEnd - the id of the actor the search reached
+ * Parameter: bit - the bit of the search
+ * Parameter: level - the level the search reached actorEnd on
+ * Parameter: context - the state of the multi source search
+ */
+string ActorGraph::formatMultiSourcePath( uint32_t actorEnd, uint64_t bit,
+                                          unsigned int level,
+                                          const QueryContext& context )
+                                          const {
+
+    //walk back to the start and add each actor and movie to a stack
+    stack<pair<uint32_t,uint32_t>> actorOrder = 
+        std::stack<std::pair<uint32_t,uint32_t>>();
+    uint32_t curActor = actorEnd;
+    for( ; level > 0; level-- ) {
+        bool found = false;
+        const uint32_t* movieEnd = csr.moviesEnd( curActor );
+        for( const uint32_t* movie = csr.moviesBegin( curActor );
+             movie != movieEnd && !found; movie++ ) {
+            const uint32_t* actorEnd = csr.actorsEnd( *movie );
+            for( const uint32_t* actor = csr.actorsBegin( *movie );
+                 actor != actorEnd; actor++ ) {
+                //go back through the actor's entries until the one it got
+                //the bit on or the level before, and see if they are the
+                //same one
+                uint32_t entry = context.actorEntries[*actor];
+                while( entry != NO_ID && entry >= context.levelStarts[level] &&
+                       (context.levelMasks[entry] & bit) == 0 ) {
+                    entry = context.earlierEntries[entry];
+                }
+                if( entry == NO_ID || entry < context.levelStarts[level - 1] ||
+                    entry >= context.levelStarts[level] ||
+                    (context.levelMasks[entry] & bit) == 0 ) {
+                    continue;
+                }
+                actorOrder.push(
+                    std::pair<uint32_t,uint32_t>( curActor, *movie ) );
+                curActor = *actor;
+                found = true;
+                break;
+            }
+        }
+    }
+
+    //start with the curNode which should be the starting actor
+    string outStr = pathStart( actorList[curActor]->name );
+    while( !actorOrder.empty() ) {
+
+        appendStep( outStr, movieList[actorOrder.top().second],
+                    actorList[actorOrder.top().first]->name );
+        actorOrder.pop();
+
+    }
+
+    return outStr;
+
 }
 
 /**
@@ -123,234 +1061,1068 @@ bool ActorGraph::loadFromFile(const char* in_filename) {
  * Parameter: actorEnd - the actor that will be found in the search
  */
 string ActorGraph::findClosestActors(string actorStart, string actorEnd) {
+    return findClosestActors( actorStart, actorEnd, defaultContext );
+}
+
+/**
+ * This method is the breadth first search of findClosestActors, keeping
+ * all of its state in the given context instead of the graph.
+ * Parameter: actorStart - the actor that will be the start of the search
+ * Parameter: actorEnd - the actor that will be found in the search
+ * Parameter: context - the search state, one per thread searching
+ */
+string ActorGraph::findClosestActors( const string& actorStart,
+                                      const string& actorEnd,
+                                      QueryContext& context ) const {
+
+    ActorNode* startNode = findActor( actorStart );
+    ActorNode* endNode = findActor( actorEnd );
+    if( startNode == 0 || endNode == 0 ) { return ""; }
+
+    vector<string> results = std::vector<string>( 1 );
+    vector<PathTarget> targets =
+        std::vector<PathTarget>( 1, PathTarget{ endNode->id, 0 } );
+    closestFrom( startNode->id, targets, results, context );
+    return results[0];
+
+}
+
+/**
+ * This method does the breadth first search of findClosestActors from one
+ * actor until every one of the targets has been popped from the queue. The
+ * search is exactly the one findClosestActors does for each target alone,
+ * it just keeps going after the first one, so every path is the same.
+ * Parameter: startActor - the id of the actor the search starts at
+ * Parameter: targets - the targets of the search sorted by actor id
+ * Parameter: results - where the path of each target is written
+ * Parameter: context - the search state, one per thread searching
+ */
+void ActorGraph::closestFrom( uint32_t startActor,
+                              const vector<PathTarget>& targets,
+                              vector<string>& results,
+                              QueryContext& context ) const {
+
+    context.begin( csr.numActors(), csr.numMovies() );
+    size_t numLeft = markTargets( targets, context );
+
+    //create a queue and add the starting actor to it
+    queue<uint32_t> actorQueue = std::queue<uint32_t>();
+    context.seeActor( startActor );
+    actorQueue.push( startActor );
+
+    //Do A BFS to find the end actors
+    while( !actorQueue.empty() ) {
+
+        //pop the curActor from the queue, set it as visited
+        uint32_t curActor = actorQueue.front(); actorQueue.pop();
+        if( context.isTarget( curActor ) ) {
+            settleTarget( curActor, targets, results, context );
+            if( --numLeft == 0 ) { break; }
+        }
+
+        //go through each movie and add the actors to the queue
+        const uint32_t* movieEnd = csr.moviesEnd( curActor );
+        for( const uint32_t* movie = csr.moviesBegin( curActor );
+             movie != movieEnd; movie++ ) {
+
+            if( context.isMovieChecked( *movie ) ) { continue; }
+            
+            //add the actors in the movies to the queue
+            const uint32_t* actorEnd = csr.actorsEnd( *movie );
+            for( const uint32_t* actor = csr.actorsBegin( *movie );
+                 actor != actorEnd; actor++ ) {
+                if( context.isActorSeen( *actor ) ) { continue; }
+                context.seeActor( *actor );
+                context.actorPrevious[*actor] = *movie;
+                actorQueue.push( *actor );
+            }
+            
+            //set the previous actor and the checked to 1
+            context.checkMovie( *movie, curActor );
+
+        }
+
+    } //end while loop
+
+}
+
+/**
+ * This method builds the rest of the formatted path of a bidirectional
+ * search, by following the next movie of each actor and the next actor of
+ * each movie from actorMeet to the ending actor.
+ * Parameter: actorMeet - the id of the actor where the two sides met
+ * Parameter: context - the context of the search that found actorMeet
+ */
+string ActorGraph::formatBackPath( uint32_t actorMeet,
+                                   const QueryContext& context ) const {
+
+    string outStr = "";
+    uint32_t curActor = actorMeet;
+    while( context.actorNext[curActor] != NO_ID ) {
+
+        const MovieNode* movie = movieList[context.actorNext[curActor]];
+        curActor = context.movieNext[movie->id];
+        appendStep( outStr, movie, actorList[curActor]->name );
+
+    }
+
+    return outStr;
+
+}
+
+/**
+ * This method expands one level of a bidirectional breadth first search.
+ * Every unchecked movie of every actor in the frontier is checked and its
+ * actors that this side has not seen are added to the next frontier. The
+ * search stops as soon as it reaches an actor the other side has seen.
+ * Parameter: frontier - the actors found in the last level of this side
+ * Parameter: nextFrontier - where the actors of the next level are added
+ * Parameter: fromStart - whether this is the side of the starting actor
+ * Parameter: context - the search state, one per thread searching
+ */
+uint32_t ActorGraph::expandFrontier( const vector<uint32_t>& frontier,
+                                     vector<uint32_t>& nextFrontier,
+                                     bool fromStart,
+                                     QueryContext& context ) const {
+
+    for( unsigned int i = 0; i < frontier.size(); i++ ) {
+
+        uint32_t curActor = frontier[i];
+        const uint32_t* movieEnd = csr.moviesEnd( curActor );
+        for( const uint32_t* movie = csr.moviesBegin( curActor );
+             movie != movieEnd; movie++ ) {
+
+            if( fromStart ) {
+                if( context.isMovieChecked( *movie ) ) { continue; }
+                context.checkMovie( *movie, curActor );
+            } else {
+                if( context.isMovieCheckedBack( *movie ) ) { continue; }
+                context.checkMovieBack( *movie, curActor );
+            }
+
+            const uint32_t* actorEnd = csr.actorsEnd( *movie );
+            for( const uint32_t* actor = csr.actorsBegin( *movie );
+                 actor != actorEnd; actor++ ) {
+
+                if( fromStart ) {
+                    if( context.isActorSeen( *actor ) ) { continue; }
+                    context.seeActor( *actor );
+                    context.actorPrevious[*actor] = *movie;
+                    if( context.isActorSeenBack( *actor ) ) { return *actor; }
+                } else {
+                    if( context.isActorSeenBack( *actor ) ) { continue; }
+                    context.seeActorBack( *actor, *movie );
+                    if( context.isActorSeen( *actor ) ) { return *actor; }
+                }
+                nextFrontier.push_back( *actor );
+
+            }
+
+        }
 
-    if( actorMap.find(actorStart) == actorMap.end() ) { return ""; }
+    }
+
+    return NO_ID;
+
+}
+
+/**
+ * This method finds a shortest path between two actors with a breadth first
+ * search from both of them at once. Each round the side with the smaller
+ * frontier is expanded by a whole level, and the search ends at the first
+ * actor seen by both sides. Since every actor next to a frontier has been
+ * seen by its own side already, the first actor found by both sides is
+ * always on a shortest path.
+ * Parameter: actorStart - the actor that will be the start of the search
+ * Parameter: actorEnd - the actor that will be found in the search
+ */
+string ActorGraph::findClosestActorsBidirectional( string actorStart,
+                                                   string actorEnd ) {
+    return findClosestActorsBidirectional( actorStart, actorEnd,
+                                           defaultContext );
+}
+
+/**
+ * This method is the bidirectional breadth first search of
+ * findClosestActorsBidirectional, keeping all of its state in the given
+ * context instead of the graph.
+ * Parameter: actorStart - the actor that will be the start of the search
+ * Parameter: actorEnd - the actor that will be found in the search
+ * Parameter: context - the search state, one per thread searching
+ */
+string ActorGraph::findClosestActorsBidirectional( const string& actorStart,
+                                                   const string& actorEnd,
+                                                   QueryContext& context )
+                                                   const {
+
+    ActorNode* startNode = findActor( actorStart );
+    ActorNode* endNode = findActor( actorEnd );
+    if( startNode == 0 || endNode == 0 ) { return ""; }
+    context.begin( csr.numActors(), csr.numMovies() );
+
+    //each side starts with only its own actor
+    context.seeActor( startNode->id );
+    context.seeActorBack( endNode->id, NO_ID );
+    if( startNode == endNode ) { return formatPath( startNode->id, context ); }
+
+    vector<uint32_t> startFrontier = std::vector<uint32_t>( 1, startNode->id );
+    vector<uint32_t> endFrontier = std::vector<uint32_t>( 1, endNode->id );
+    vector<uint32_t> nextFrontier = std::vector<uint32_t>();
+    uint32_t actorMeet = NO_ID;
+    while( actorMeet == NO_ID && !startFrontier.empty() &&
+           !endFrontier.empty() ) {
+
+        //grow the smaller side, it has the fewest edges to look at
+        bool fromStart = startFrontier.size() <= endFrontier.size();
+        vector<uint32_t>& frontier = fromStart ? startFrontier : endFrontier;
+        nextFrontier.clear();
+        actorMeet = expandFrontier( frontier, nextFrontier, fromStart,
+                                    context );
+        frontier.swap( nextFrontier );
+
+    }
+
+    //check to see if the two sides ever met
+    if( actorMeet == NO_ID ) { return ""; }
+    return formatPath( actorMeet, context ) +
+           formatBackPath( actorMeet, context );
+
+}
+
+/* Returns whether a bit of a frontier bitmap is set
+ * Parameter: bits - the bitmap
+ * Parameter: id - the id of the actor or movie
+ */
+static inline bool testBit( const vector<uint64_t>& bits, uint32_t id ) {
+    return (bits[id >> 6] >> (id & 63)) & 1;
+}
+
+/* Sets a bit of a frontier bitmap
+ * Parameter: bits - the bitmap
+ * Parameter: id - the id of the actor or movie
+ */
+static inline void setBit( vector<uint64_t>& bits, uint32_t id ) {
+    bits[id >> 6] |= (uint64_t)1 << (id & 63);
+}
+
+/* Clears the bits of every id in a frontier, leaving the whole bitmap clear
+ * Parameter: bits - the bitmap
+ * Parameter: frontier - the ids whose bits are set
+ */
+static void clearBits( vector<uint64_t>& bits,
+                       const vector<uint32_t>& frontier ) {
+    for( unsigned int i = 0; i < frontier.size(); i++ ) {
+        bits[frontier[i] >> 6] = 0;
+    }
+}
+
+/* Decides which way the next step of a direction optimizing search goes.
+ * Top down looks at every edge of the frontier, bottom up looks at the
+ * edges of the unexplored nodes on the other side until each one finds a
+ * neighbor in the frontier, so bottom up wins once the frontier is large.
+ * Parameter: bottomUp - whether the last step on this side was bottom up
+ * Parameter: frontierEdges - the number of edges out of the frontier
+ * Parameter: edgesLeft - the number of edges of the unexplored nodes
+ * Parameter: frontierSize - the number of nodes in the frontier
+ * Parameter: numNodes - the number of nodes on the frontier's side
+ */
+static bool useBottomUp( bool bottomUp, uint64_t frontierEdges,
+                         uint64_t edgesLeft, uint64_t frontierSize,
+                         uint64_t numNodes ) {
+    if( !bottomUp ) { return frontierEdges > edgesLeft / BOTTOM_UP_EDGES; }
+    return frontierSize >= numNodes / TOP_DOWN_NODES;
+}
+
+/**
+ * This method finds the number of movies between the given actor and every
+ * other actor in the graph, which is the Bacon number of every actor when
+ * the given actor is Kevin Bacon. The distances are in the order the actors
+ * were added to the graph and actors that cannot be reached are (unsigned)-1.
+ * Parameter: actor - the actor every distance is measured from
+ */
+vector<unsigned int> ActorGraph::findActorDistances( string actor ) {
+    return findActorDistances( actor, defaultContext );
+}
+
+/**
+ * This method is the direction optimizing breadth first search of
+ * findActorDistances. Every level is two steps, from the actor frontier to
+ * the movies it reaches and from those movies to the actors they reach.
+ * Each step either goes top down, through the edges of its frontier, or
+ * bottom up, where every unexplored node on the other side looks through
+ * its own edges for one in the frontier bitmap and stops at the first.
+ * Once a hub pulls most of the graph into the frontier the bottom up steps
+ * only look at a small part of the edges the top down steps would.
+ * Parameter: actor - the actor every distance is measured from
+ * Parameter: context - the search state, one per thread searching
+ */
+vector<unsigned int> ActorGraph::findActorDistances(
+    const string& actor, QueryContext& context ) const {
+
+    uint32_t numActors = csr.numActors();
+    uint32_t numMovies = csr.numMovies();
+    vector<unsigned int> actorDist =
+        std::vector<unsigned int>( numActors, (unsigned)-1 );
+    ActorNode* startNode = findActor( actor );
+    if( startNode == 0 ) { return actorDist; }
+    context.begin( numActors, numMovies );
+
+    vector<uint32_t> actorFrontier =
+        std::vector<uint32_t>( 1, startNode->id );
+    vector<uint32_t> movieFrontier = std::vector<uint32_t>();
+    actorDist[startNode->id] = 0;
+    setBit( context.actorBits, startNode->id );
+    //the edges of the actors and movies that have not been reached yet
+    uint64_t actorEdgesLeft =
+        csr.numCredits() - csr.numMoviesOf( startNode->id );
+    uint64_t movieEdgesLeft = csr.numCredits();
+    bool moviesBottomUp = false;
+    bool actorsBottomUp = false;
+
+    for( unsigned int level = 1; !actorFrontier.empty(); level++ ) {
+
+        //step from the actor frontier to the movies it reaches
+        uint64_t frontierEdges = 0;
+        for( unsigned int i = 0; i < actorFrontier.size(); i++ ) {
+            frontierEdges += csr.numMoviesOf( actorFrontier[i] );
+        }
+        moviesBottomUp = useBottomUp( moviesBottomUp, frontierEdges,
+                                      movieEdgesLeft, actorFrontier.size(),
+                                      numActors );
+        movieFrontier.clear();
+        if( moviesBottomUp ) {
+            for( uint32_t movie = 0; movie < numMovies; movie++ ) {
+                if( context.isMovieChecked( movie ) ) { continue; }
+                const uint32_t* actorEnd = csr.actorsEnd( movie );
+                for( const uint32_t* tmp = csr.actorsBegin( movie );
+                     tmp != actorEnd; tmp++ ) {
+                    if( !testBit( context.actorBits, *tmp ) ) { continue; }
+                    context.checkMovie( movie, *tmp );
+                    movieFrontier.push_back( movie );
+                    break;
+                }
+            }
+        } else {
+            for( unsigned int i = 0; i < actorFrontier.size(); i++ ) {
+                const uint32_t* movieEnd = csr.moviesEnd( actorFrontier[i] );
+                for( const uint32_t* movie =
+                         csr.moviesBegin( actorFrontier[i] );
+                     movie != movieEnd; movie++ ) {
+                    if( context.isMovieChecked( *movie ) ) { continue; }
+                    context.checkMovie( *movie, actorFrontier[i] );
+                    movieFrontier.push_back( *movie );
+                }
+            }
+        }
+        clearBits( context.actorBits, actorFrontier );
+        for( unsigned int i = 0; i < movieFrontier.size(); i++ ) {
+            setBit( context.movieBits, movieFrontier[i] );
+            movieEdgesLeft -= csr.numActorsOf( movieFrontier[i] );
+        }
+
+        //step from the movie frontier to the actors it reaches
+        frontierEdges = 0;
+        for( unsigned int i = 0; i < movieFrontier.size(); i++ ) {
+            frontierEdges += csr.numActorsOf( movieFrontier[i] );
+        }
+        actorsBottomUp = useBottomUp( actorsBottomUp, frontierEdges,
+                                      actorEdgesLeft, movieFrontier.size(),
+                                      numMovies );
+        actorFrontier.clear();
+        if( actorsBottomUp ) {
+            for( uint32_t tmp = 0; tmp < numActors; tmp++ ) {
+                if( actorDist[tmp] != (unsigned)-1 ) { continue; }
+                const uint32_t* movieEnd = csr.moviesEnd( tmp );
+                for( const uint32_t* movie = csr.moviesBegin( tmp );
+                     movie != movieEnd; movie++ ) {
+                    if( !testBit( context.movieBits, *movie ) ) { continue; }
+                    actorDist[tmp] = level;
+                    actorFrontier.push_back( tmp );
+                    break;
+                }
+            }
+        } else {
+            for( unsigned int i = 0; i < movieFrontier.size(); i++ ) {
+                const uint32_t* actorEnd = csr.actorsEnd( movieFrontier[i] );
+                for( const uint32_t* tmp =
+                         csr.actorsBegin( movieFrontier[i] );
+                     tmp != actorEnd; tmp++ ) {
+                    if( actorDist[*tmp] != (unsigned)-1 ) { continue; }
+                    actorDist[*tmp] = level;
+                    actorFrontier.push_back( *tmp );
+                }
+            }
+        }
+        clearBits( context.movieBits, movieFrontier );
+        for( unsigned int i = 0; i < actorFrontier.size(); i++ ) {
+            setBit( context.actorBits, actorFrontier[i] );
+            actorEdgesLeft -= csr.numMoviesOf( actorFrontier[i] );
+        }
+
+    }
+
+    return actorDist;
+
+}
+
+/**
+ * This method builds the distance oracle of the graph, replacing any oracle
+ * it had before. It has to be built again whenever the graph changes.
+ */
+void ActorGraph::buildDistanceOracle() {
+    oracle.build( csr );
+}
+
+/**
+ * This method writes the distance oracle to a file. Returns false if there
+ * is no oracle for the graph or the file could not be written.
+ * Parameter: out_filename - the name of the oracle file to write
+ */
+bool ActorGraph::saveDistanceOracle( const char* out_filename ) const {
+
+    if( !oracle.covers( csr.numActors() ) ) {
+        cerr << "There is no distance oracle to save!\n";
+        return false;
+    }
+    return oracle.save( out_filename, csr );
+
+}
+
+/**
+ * This method loads a distance oracle saved by saveDistanceOracle. Returns
+ * false if the file is not an oracle of this graph.
+ * Parameter: in_filename - the name of the oracle file to load
+ */
+bool ActorGraph::loadDistanceOracle( const char* in_filename ) {
+    return oracle.load( in_filename, csr );
+}
+
+/**
+ * This method finds the number of movies between two actors with the
+ * distance oracle. It returns (unsigned)-1 if either actor is not in the
+ * graph, they are not connected or there is no oracle for the graph.
+ * Parameter: actorStart - the actor the distance is measured from
+ * Parameter: actorEnd - the actor the distance is measured to
+ */
+unsigned int ActorGraph::findActorDistance( const string& actorStart,
+                                            const string& actorEnd ) const {
+
+    ActorNode* startNode = findActor( actorStart );
+    ActorNode* endNode = findActor( actorEnd );
+    if( startNode == 0 || endNode == 0 ||
+        !oracle.covers( csr.numActors() ) ) {
+        return (unsigned)-1;
+    }
+    if( startNode == endNode ) { return 0; }
+    return oracle.distance( startNode->id, endNode->id );
+
+}
+
+/**
+ * This method finds a shortest path between two actors with the distance
+ * oracle instead of a search. From the starting actor it steps to any
+ * co-star that is one movie closer to the ending actor, so it only looks at
+ * the co-stars of the actors on the path. The path is formatted the same
+ * way as by findClosestActors, but may be a different one when there are
+ * ties. Returns an empty string when findActorDistance would not give a
+ * distance.
+ * Parameter: actorStart - the actor that will be the start of the path
+ * Parameter: actorEnd - the actor that will be the end of the path
+ */
+string ActorGraph::findOraclePath( const string& actorStart,
+                                   const string& actorEnd ) const {
+
+    unsigned int dist = findActorDistance( actorStart, actorEnd );
+    if( dist == (unsigned)-1 ) { return ""; }
+
+    uint32_t curActor = findActor( actorStart )->id;
+    uint32_t endActor = findActor( actorEnd )->id;
+    string outStr = pathStart( actorList[curActor]->name );
+    while( dist > 0 ) {
+
+        //some co-star has to be exactly one movie closer
+        uint32_t nextActor = NO_ID;
+        uint32_t nextMovie = NO_ID;
+        const uint32_t* movieEnd = csr.moviesEnd( curActor );
+        for( const uint32_t* movie = csr.moviesBegin( curActor );
+             movie != movieEnd && nextActor == NO_ID; movie++ ) {
+            const uint32_t* actorEnd = csr.actorsEnd( *movie );
+            for( const uint32_t* tmp = csr.actorsBegin( *movie );
+                 tmp != actorEnd; tmp++ ) {
+                if( oracle.distance( *tmp, endActor ) == dist - 1 ) {
+                    nextActor = *tmp;
+                    nextMovie = *movie;
+                    break;
+                }
+            }
+        }
+
+        //only an oracle that does not match the graph can get here
+        if( nextActor == NO_ID ) { return ""; }
+        appendStep( outStr, movieList[nextMovie],
+                    actorList[nextActor]->name );
+        curActor = nextActor;
+        dist--;
+
+    }
+
+    return outStr;
+
+}
+
+/**
+ * This method uses Dijkstra's Algoritm to find the closest actor
+ * and movie chain from actorStart to actorEnd. The difference between
+ * This algorithm and the findClosestActors alorithm is that the graph
+ * for this one is weighted by movie age, so we can't effectively use
+ * a Breadth First Search, we have to use Dijkstra's.
+ * Parameter: actorStart - the starting actor in the actor/movie chain
+ * Parameter: actorEnd - the ending actor in the actor/movie chain
+ */
+string ActorGraph::findWeightedActors(string actorStart, string actorEnd) {
+    return findWeightedActors( actorStart, actorEnd, defaultContext );
+}
+
+/**
+ * This method is the Dijkstra's search of findWeightedActors, keeping
+ * all of its state in the given context instead of the graph.
+ * Parameter: actorStart - the starting actor in the actor/movie chain
+ * Parameter: actorEnd - the ending actor in the actor/movie chain
+ * Parameter: context - the search state, one per thread searching
+ */
+string ActorGraph::findWeightedActors( const string& actorStart,
+                                       const string& actorEnd,
+                                       QueryContext& context ) const {
+
+    ActorNode* startNode = findActor( actorStart );
+    ActorNode* endNode = findActor( actorEnd );
+    if( startNode == 0 || endNode == 0 ) { return ""; }
+
+    vector<string> results = std::vector<string>( 1 );
+    vector<PathTarget> targets =
+        std::vector<PathTarget>( 1, PathTarget{ endNode->id, 0 } );
+    weightedFrom( startNode->id, targets, results, context );
+    return results[0];
+
+}
+
+/**
+ * This method does the Dijkstra's search of findWeightedActors from one
+ * actor until every one of the targets has been popped from the queue. The
+ * path of a target is built the moment it is popped, so every path is the
+ * same one findWeightedActors finds for that target alone.
+ * Parameter: startActor - the id of the actor the search starts at
+ * Parameter: targets - the targets of the search sorted by actor id
+ * Parameter: results - where the path of each target is written
+ * Parameter: context - the search state, one per thread searching
+ */
+void ActorGraph::weightedFrom( uint32_t startActor,
+                               const vector<PathTarget>& targets,
+                               vector<string>& results,
+                               QueryContext& context ) const {
+
+    context.begin( csr.numActors(), csr.numMovies() );
+    size_t numLeft = markTargets( targets, context );
+
+    //create a priority queue of (distance, actor) pairs and add the
+    //starting actor to it, an actor is pushed again every time it gets
+    //closer and the pairs left behind are skipped when they are popped
+    priority_queue<pair<unsigned int, uint32_t>,
+                   vector<pair<unsigned int, uint32_t>>,
+                   greater<pair<unsigned int, uint32_t>>> actorQueue =
+        std::priority_queue<pair<unsigned int, uint32_t>,
+                            vector<pair<unsigned int, uint32_t>>,
+                            greater<pair<unsigned int, uint32_t>>>();
+
+    uint32_t curActor = startActor;
+    context.seeActor( curActor );
+    context.actorDist[curActor] = 0;
+    actorQueue.push( pair<unsigned int, uint32_t>( 0, curActor ) );
+
+    //use Dijkstra's algorithm
+    while( !actorQueue.empty() ) {
+
+        //pop the curActor from the queue, set it as visited
+        curActor = actorQueue.top().second; actorQueue.pop();
+        if( context.isActorChecked( curActor ) ) { continue; }
+        if( context.isTarget( curActor ) ) {
+            settleTarget( curActor, targets, results, context );
+            if( --numLeft == 0 ) { break; }
+        }
+        context.checkActor( curActor );
+        
+        //go through each movie and add the actors to the queue
+        const uint32_t* movieEnd = csr.moviesEnd( curActor );
+        for( const uint32_t* movie = csr.moviesBegin( curActor );
+             movie != movieEnd; movie++ ) {
+
+            if( context.isMovieChecked( *movie ) ) { continue; }
+            
+            //add the actors in the movies to the queue
+            unsigned int totalDist =
+                context.actorDist[curActor] + csr.movieWeights[*movie];
+            const uint32_t* actorEnd = csr.actorsEnd( *movie );
+            for( const uint32_t* actor = csr.actorsBegin( *movie );
+                 actor != actorEnd; actor++ ) {
+                
+                if( totalDist < context.dist( *actor ) ) {
+                    if( !context.isActorSeen( *actor ) ) {
+                        context.seeActor( *actor );
+                    }
+                    context.actorDist[*actor] = totalDist;
+                    context.actorPrevious[*actor] = *movie;
+                    actorQueue.push(
+                        pair<unsigned int, uint32_t>( totalDist, *actor ) );
+                }
+            
+            }
+            
+            //set the previous actor and the checked to 1
+            context.checkMovie( *movie, curActor );
+
+        }
+
+    }
+
+}
+
+
+/**
+ * This method finds the same kind of path as findWeightedActors with
+ * Dial's algorithm. Movie weights are small integers, so instead of a binary
+ * heap the actors wait in one bucket per distance. Since no movie weighs
+ * more than the heaviest one, only that many buckets plus one are ever in
+ * use at a time and they are reused in a circle. When there are several
+ * lightest paths it may return a different one than findWeightedActors.
+ * Parameter: actorStart - the starting actor in the actor/movie chain
+ * Parameter: actorEnd - the ending actor in the actor/movie chain
+ */
+string ActorGraph::findWeightedActorsDial(string actorStart, string actorEnd) {
+    return findWeightedActorsDial( actorStart, actorEnd, defaultContext );
+}
+
+/**
+ * This method is the bucket queue search of findWeightedActorsDial,
+ * keeping all of its state in the given context instead of the graph.
+ * Parameter: actorStart - the starting actor in the actor/movie chain
+ * Parameter: actorEnd - the ending actor in the actor/movie chain
+ * Parameter: context - the search state, one per thread searching
+ */
+string ActorGraph::findWeightedActorsDial( const string& actorStart,
+                                           const string& actorEnd,
+                                           QueryContext& context ) const {
+
+    ActorNode* startNode = findActor( actorStart );
+    ActorNode* endNode = findActor( actorEnd );
+    if( startNode == 0 || endNode == 0 ) { return ""; }
+
+    vector<string> results = std::vector<string>( 1 );
+    vector<PathTarget> targets =
+        std::vector<PathTarget>( 1, PathTarget{ endNode->id, 0 } );
+    weightedFromDial( startNode->id, targets, results, context );
+    return results[0];
+
+}
+
+/**
+ * This method does the bucket queue search of findWeightedActorsDial from
+ * one actor until every one of the targets has been taken out of a bucket.
+ * Parameter: startActor - the id of the actor the search starts at
+ * Parameter: targets - the targets of the search sorted by actor id
+ * Parameter: results - where the path of each target is written
+ * Parameter: context - the search state, one per thread searching
+ */
+void ActorGraph::weightedFromDial( uint32_t startActor,
+                                   const vector<PathTarget>& targets,
+                                   vector<string>& results,
+                                   QueryContext& context ) const {
+
+    //a graph with very heavy movies would need too many buckets
+    if( csr.maxWeight >= MAX_DIST_BUCKETS ) {
+        weightedFrom( startActor, targets, results, context );
+        return;
+    }
+    context.begin( csr.numActors(), csr.numMovies() );
+    size_t numLeft = markTargets( targets, context );
+
+    //a search that found its actor early leaves its buckets behind
+    uint32_t numBuckets = csr.maxWeight + 1;
+    vector<vector<uint32_t>>& buckets = context.distBuckets;
+    if( buckets.size() < numBuckets ) { buckets.resize( numBuckets ); }
+    for( uint32_t i = 0; i < numBuckets; i++ ) { buckets[i].clear(); }
+
+    context.seeActor( startActor );
+    context.actorDist[startActor] = 0;
+    buckets[0].push_back( startActor );
+    size_t numQueued = 1;
+
+    //empty the buckets in order of distance
+    for( unsigned int curDist = 0; numQueued > 0 && numLeft > 0; curDist++ ) {
+
+        //movies of weight 0 add to the bucket while it is being emptied
+        vector<uint32_t>& bucket = buckets[curDist % numBuckets];
+        for( size_t i = 0; i < bucket.size(); i++ ) {
+
+            uint32_t curActor = bucket[i];
+            numQueued--;
+            //skip the copies left behind when an actor got closer
+            if( context.actorDist[curActor] != curDist ||
+                context.isActorChecked( curActor ) ) { continue; }
+            if( context.isTarget( curActor ) ) {
+                settleTarget( curActor, targets, results, context );
+                if( --numLeft == 0 ) { break; }
+            }
+            context.checkActor( curActor );
+
+            const uint32_t* movieEnd = csr.moviesEnd( curActor );
+            for( const uint32_t* movie = csr.moviesBegin( curActor );
+                 movie != movieEnd; movie++ ) {
+
+                if( context.isMovieChecked( *movie ) ) { continue; }
+                unsigned int totalDist = curDist + csr.movieWeights[*movie];
+                vector<uint32_t>& target = buckets[totalDist % numBuckets];
+                const uint32_t* actorEnd = csr.actorsEnd( *movie );
+                for( const uint32_t* actor = csr.actorsBegin( *movie );
+                     actor != actorEnd; actor++ ) {
+                    if( totalDist >= context.dist( *actor ) ) { continue; }
+                    if( !context.isActorSeen( *actor ) ) {
+                        context.seeActor( *actor );
+                    }
+                    context.actorDist[*actor] = totalDist;
+                    context.actorPrevious[*actor] = *movie;
+                    target.push_back( *actor );
+                    numQueued++;
+                }
+                context.checkMovie( *movie, curActor );
+
+            }
+
+        }
+        bucket.clear();
+
+    }
+
+}
 
-    //create a queue and add the starting actor to it
-    ActorNode* curActor = actorMap.find(actorStart)->second;
-    queue<ActorNode*> actorQueue = std::queue<ActorNode*>();
-    curActor->checked = true;
-    actorQueue.push( curActor );
+/**
+ * This method finds the same kind of path as findWeightedActors with a
+ * bidirectional Dijkstra's search. When there are several lightest paths
+ * it may return a different one than findWeightedActors.
+ * Parameter: actorStart - the starting actor in the actor/movie chain
+ * Parameter: actorEnd - the ending actor in the actor/movie chain
+ */
+string ActorGraph::findWeightedActorsBidirectional( string actorStart,
+                                                    string actorEnd ) {
+    return findWeightedActorsBidirectional( actorStart, actorEnd,
+                                            defaultContext );
+}
 
-    //create a list to clean up the movies and the actors
-    vector<ActorNode*> actorCleanup = std::vector<ActorNode*>();
-    vector<MovieNode*> movieCleanup = std::vector<MovieNode*>();
-    actorCleanup.push_back( curActor );
+/**
+ * This method is the bidirectional Dijkstra's search of
+ * findWeightedActorsBidirectional. Both sides are Dijkstra's algorithm over
+ * the movies the same way as findWeightedActors, one from each actor, and
+ * the side whose next actor is closer always goes next. The sides meet at
+ * movies: once both have checked a movie, the lightest path through it is
+ * the path to the actor that checked it from the start, the movie itself
+ * and the path from the actor that checked it from the end. The search
+ * stops once the next actors of the two sides are together no closer than
+ * the lightest path found so far, since no path through an actor neither
+ * side has finished can be lighter than that. A side with no actors left
+ * counts as infinitely far, so the other side keeps going until it meets
+ * it or runs out too.
+ * Parameter: actorStart - the starting actor in the actor/movie chain
+ * Parameter: actorEnd - the ending actor in the actor/movie chain
+ * Parameter: context - the search state, one per thread searching
+ */
+string ActorGraph::findWeightedActorsBidirectional( const string& actorStart,
+                                                    const string& actorEnd,
+                                                    QueryContext& context )
+                                                    const {
+
+    ActorNode* startNode = findActor( actorStart );
+    ActorNode* endNode = findActor( actorEnd );
+    if( startNode == 0 || endNode == 0 ) { return ""; }
+    context.begin( csr.numActors(), csr.numMovies() );
+    if( startNode == endNode ) {
+        context.seeActor( startNode->id );
+        return formatPath( startNode->id, context );
+    }
 
-    //Do A BFS to find the end actor
-    while( !actorQueue.empty() ) {
+    //the queues hold (distance, actor) pairs, the start side first
+    priority_queue<pair<unsigned int, uint32_t>,
+                   vector<pair<unsigned int, uint32_t>>,
+                   greater<pair<unsigned int, uint32_t>>> queues[2] = {
+        std::priority_queue<pair<unsigned int, uint32_t>,
+                            vector<pair<unsigned int, uint32_t>>,
+                            greater<pair<unsigned int, uint32_t>>>(),
+        std::priority_queue<pair<unsigned int, uint32_t>,
+                            vector<pair<unsigned int, uint32_t>>,
+                            greater<pair<unsigned int, uint32_t>>>() };
+    context.seeActor( startNode->id );
+    context.actorDist[startNode->id] = 0;
+    context.seeActorBack( endNode->id, NO_ID );
+    context.actorDistBack[endNode->id] = 0;
+    queues[0].push( pair<unsigned int, uint32_t>( 0, startNode->id ) );
+    queues[1].push( pair<unsigned int, uint32_t>( 0, endNode->id ) );
+
+    unsigned int bestDist = (unsigned)-1;
+    uint32_t bestMovie = NO_ID;
+    while( true ) {
+
+        //drop the actors each side has finished already
+        while( !queues[0].empty() &&
+               context.isActorChecked( queues[0].top().second ) ) {
+            queues[0].pop();
+        }
+        while( !queues[1].empty() &&
+               context.isActorCheckedBack( queues[1].top().second ) ) {
+            queues[1].pop();
+        }
+        //a side that runs out has reached every actor it can, but the other
+        //side may still meet the movies it checked, so it is only done
+        //once both have run out
+        if( queues[0].empty() && queues[1].empty() ) { break; }
+        uint64_t startTop = queues[0].empty() ? UINT64_MAX / 2
+                                              : queues[0].top().first;
+        uint64_t endTop = queues[1].empty() ? UINT64_MAX / 2
+                                            : queues[1].top().first;
+        if( bestDist != (unsigned)-1 && startTop + endTop >= bestDist ) {
+            break;
+        }
 
-        //pop the curActor from the queue, set it as visited
-        curActor = actorQueue.front(); actorQueue.pop();
-        if( curActor->name == actorEnd ) { break; }
+        bool fromStart = startTop <= endTop;
+        uint32_t curActor = queues[!fromStart].top().second;
+        unsigned int curDist = queues[!fromStart].top().first;
+        queues[!fromStart].pop();
+        if( fromStart ) {
+            context.checkActor( curActor );
+        } else {
+            context.checkActorBack( curActor );
+        }
 
-        //go through each movie and add the actors to the queue
-        for( unsigned int i = 0; i < curActor->movies.size(); i++ ) {
+        const uint32_t* movieEnd = csr.moviesEnd( curActor );
+        for( const uint32_t* movie = csr.moviesBegin( curActor );
+             movie != movieEnd; movie++ ) {
 
-            MovieNode* curMov = curActor->movies.at(i);
-            if( curMov->checked == true ) { continue; }
-            
-            //add the actors in the movies to the queue
-            for( unsigned int j = 0; j < curMov->actors.size(); j++ ) {
-                if( curMov->actors.at(j)->checked == true ) { continue; }
-                curMov->actors.at(j)->checked = true;
-                curMov->actors.at(j)->previous = curMov;
-                actorQueue.push( curMov->actors.at(j) );
-                actorCleanup.push_back( curMov->actors.at(j) );
+            //the first actor of a side to check a movie is its closest
+            if( fromStart ? context.isMovieChecked( *movie )
+                          : context.isMovieCheckedBack( *movie ) ) {
+                continue;
+            }
+            unsigned int totalDist = curDist + csr.movieWeights[*movie];
+            if( fromStart ) {
+                context.checkMovie( *movie, curActor );
+            } else {
+                context.checkMovieBack( *movie, curActor );
             }
-            
-            //set the previous actor and the checked to 1
-            curMov->previous = curActor;
-            curMov->checked = true;
-            movieCleanup.push_back( curMov );
 
-        }
+            //see if the movie joins the two sides into a lighter path
+            bool otherChecked = fromStart
+                                    ? context.isMovieCheckedBack( *movie )
+                                    : context.isMovieChecked( *movie );
+            if( otherChecked ) {
+                unsigned int otherDist = fromStart
+                    ? context.actorDistBack[context.movieNext[*movie]]
+                    : context.actorDist[context.moviePrevious[*movie]];
+                if( totalDist + otherDist < bestDist ) {
+                    bestDist = totalDist + otherDist;
+                    bestMovie = *movie;
+                }
+            }
 
-    } //end while loop
-    
-    //check to see if we even found the node at all
-    if( curActor == 0 || curActor->name != actorEnd ) {
+            const uint32_t* actorEnd = csr.actorsEnd( *movie );
+            for( const uint32_t* actor = csr.actorsBegin( *movie );
+                 actor != actorEnd; actor++ ) {
+                if( fromStart ) {
+                    if( totalDist >= context.dist( *actor ) ) { continue; }
+                    if( !context.isActorSeen( *actor ) ) {
+                        context.seeActor( *actor );
+                    }
+                    context.actorDist[*actor] = totalDist;
+                    context.actorPrevious[*actor] = *movie;
+                } else {
+                    if( totalDist >= context.distBack( *actor ) ) {
+                        continue;
+                    }
+                    context.seeActorBack( *actor, *movie );
+                    context.actorDistBack[*actor] = totalDist;
+                }
+                queues[!fromStart].push(
+                    pair<unsigned int, uint32_t>( totalDist, *actor ) );
+            }
 
-        //clean up the actor nodes and movie nodes
-        for( unsigned int i = 0; i < actorCleanup.size(); i++ ) {
-            actorCleanup[i]->previous = 0;
-            actorCleanup[i]->checked = false;
-        }
-        for( unsigned int i = 0; i < movieCleanup.size(); i++ ) {
-            movieCleanup[i]->previous = 0;
-            movieCleanup[i]->checked = false;
         }
-        return "";
-    
-    }
-
-    //backtrack to the start node and add each actor and movie to a stack
-    stack<pair<ActorNode*,MovieNode*>> actorOrder = 
-        std::stack<std::pair<ActorNode*,MovieNode*>>();
-    while( curActor->previous != 0 ) {
-    
-        MovieNode* movieEdge = curActor->previous;
-        //add the node and edge to a pair and to the stack
-        pair<ActorNode*,MovieNode*> stackPair = 
-            std::pair<ActorNode*,MovieNode*>( curActor, movieEdge );
-        actorOrder.push( stackPair );
-        curActor = curActor->previous->previous;
 
     }
-    
-    //start with the curNode which should be the starting actor
-    string outStr = "(" + curActor->name + ")";
-    //go through each pair in the stack and add it to the string
-    while( !actorOrder.empty() ) {
+    if( bestMovie == NO_ID ) { return ""; }
 
-        string actorName = actorOrder.top().first->name;
-        string movieName = actorOrder.top().second->name;
-        string movieYear = to_string(actorOrder.top().second->year);
-        string formatStr = "--[" + movieName + "#@" + movieYear + 
-                           "]-->(" + actorName + ")";
-        outStr += formatStr;
-        actorOrder.pop();
-
-    }
-    
-    //clean up the actor nodes and movie nodes
-    for( unsigned int i = 0; i < actorCleanup.size(); i++ ) {
-        actorCleanup[i]->previous = 0;
-        actorCleanup[i]->checked = false;
-    }
-    for( unsigned int i = 0; i < movieCleanup.size(); i++ ) {
-        movieCleanup[i]->previous = 0;
-        movieCleanup[i]->checked = false;
-    }
+    //join the path to the movie from the start with the one to the end
+    uint32_t actorNext = context.movieNext[bestMovie];
+    string outStr = formatPath( context.moviePrevious[bestMovie], context );
+    appendStep( outStr, movieList[bestMovie], actorList[actorNext]->name );
+    return outStr + formatBackPath( actorNext, context );
 
-    //return the string
-    return outStr;
+}
 
+/**
+ * This method picks landmark actors and finds their distance to every
+ * actor for findWeightedActorsALT, replacing any landmarks from before.
+ * They have to be picked again whenever the graph changes.
+ * Parameter: numLandmarks - the number of landmarks to pick
+ */
+void ActorGraph::buildLandmarks( unsigned int numLandmarks ) {
+    landmarks.build( csr, numLandmarks );
 }
 
 /**
- * This method uses Dijkstra's Algoritm to find the closest actor
- * and movie chain from actorStart to actorEnd. The difference between
- * This algorithm and the findClosestActors alorithm is that the graph
- * for this one is weighted by movie age, so we can't effectively use
- * a Breadth First Search, we have to use Dijkstra's.
+ * This method finds the same kind of path as findWeightedActors with an A*
+ * search that uses the landmarks to tell how far every actor still is from
+ * actorEnd. When there are several lightest paths it may return a
+ * different one than findWeightedActors.
  * Parameter: actorStart - the starting actor in the actor/movie chain
  * Parameter: actorEnd - the ending actor in the actor/movie chain
  */
-string ActorGraph::findWeightedActors(string actorStart, string actorEnd) {
+string ActorGraph::findWeightedActorsALT(string actorStart, string actorEnd) {
+    return findWeightedActorsALT( actorStart, actorEnd, defaultContext );
+}
 
-    if( actorMap.find(actorStart) == actorMap.end() ) { return ""; }
+/**
+ * This method is the A* search of findWeightedActorsALT, keeping all of its
+ * state in the given context instead of the graph.
+ * Parameter: actorStart - the starting actor in the actor/movie chain
+ * Parameter: actorEnd - the ending actor in the actor/movie chain
+ * Parameter: context - the search state, one per thread searching
+ */
+string ActorGraph::findWeightedActorsALT( const string& actorStart,
+                                          const string& actorEnd,
+                                          QueryContext& context ) const {
 
-    //create a priority queue and add the starting actor to it
-    ActorNode* curActor = 0;
-    priority_queue<ActorNode*, vector<ActorNode*>, CompareDist> actorQueue =
-        std::priority_queue<ActorNode*, vector<ActorNode*>, CompareDist>();
+    ActorNode* startNode = findActor( actorStart );
+    ActorNode* endNode = findActor( actorEnd );
+    if( startNode == 0 || endNode == 0 ) { return ""; }
+    return weightedPathALT( startNode->id, endNode->id, context );
 
-    ActorNode* tmpActor = actorMap.find(actorStart)->second;
-    tmpActor->dist = 0;
-    actorQueue.push( tmpActor );
+}
 
-    //create a list to clean up the movies and the actors
-    vector<ActorNode*> actorCleanup = std::vector<ActorNode*>();
-    vector<MovieNode*> movieCleanup = std::vector<MovieNode*>();
-    actorCleanup.push_back( tmpActor );
+/**
+ * This method does the A* search of findWeightedActorsALT. Actors are taken
+ * in order of their distance from the start plus the landmark bound on
+ * their distance to the end, so the search heads towards the end and
+ * leaves most of the graph it would otherwise finish untouched. The bound
+ * never overestimates and never drops by more than a movie's weight between
+ * two co-stars, so every actor that is taken has its shortest distance
+ * already, just like in Dijkstra's algorithm. It also means a co-star's
+ * distance plus bound is at most twice the heaviest movie more than the
+ * actor being taken, so the actors wait in buckets the same way as in
+ * findWeightedActorsDial, just with twice as many. Unlike Dijkstra's
+ * algorithm an actor can be taken after a co-star that is farther from the
+ * start, so a movie is gone through again whenever it is reached from an
+ * actor closer to the start than the one that reached it first.
+ * Parameter: startActor - the id of the actor the search starts at
+ * Parameter: endActor - the id of the actor the search is looking for
+ * Parameter: context - the search state, one per thread searching
+ */
+string ActorGraph::weightedPathALT( uint32_t startActor, uint32_t endActor,
+                                    QueryContext& context ) const {
+
+    //a graph with very heavy movies would need too many buckets
+    if( csr.maxWeight >= MAX_DIST_BUCKETS / 2 ) {
+        vector<string> results = std::vector<string>( 1 );
+        vector<PathTarget> targets =
+            std::vector<PathTarget>( 1, PathTarget{ endActor, 0 } );
+        weightedFrom( startActor, targets, results, context );
+        return results[0];
+    }
 
-    //use Dijkstra's algorithm
-    while( !actorQueue.empty() ) {
+    //a landmark can tell that the actors are not connected at all
+    uint32_t startBound = landmarks.bound( startActor, endActor );
+    if( startBound == (uint32_t)-1 ) { return ""; }
+    context.begin( csr.numActors(), csr.numMovies() );
+
+    uint32_t numBuckets = 2 * csr.maxWeight + 1;
+    vector<vector<uint32_t>>& buckets = context.distBuckets;
+    if( buckets.size() < numBuckets ) { buckets.resize( numBuckets ); }
+    for( uint32_t i = 0; i < numBuckets; i++ ) { buckets[i].clear(); }
+
+    context.seeActor( startActor );
+    context.actorDist[startActor] = 0;
+    context.actorBound[startActor] = startBound;
+    buckets[startBound % numBuckets].push_back( startActor );
+    size_t numQueued = 1;
+
+    //empty the buckets in order of distance plus bound
+    for( unsigned int curKey = startBound; numQueued > 0; curKey++ ) {
+
+        vector<uint32_t>& bucket = buckets[curKey % numBuckets];
+        for( size_t i = 0; i < bucket.size(); i++ ) {
+
+            uint32_t curActor = bucket[i];
+            numQueued--;
+            //skip the copies left behind when an actor got closer
+            unsigned int curDist = context.actorDist[curActor];
+            if( curDist + context.actorBound[curActor] != curKey ||
+                context.isActorChecked( curActor ) ) { continue; }
+            if( curActor == endActor ) {
+                return formatPath( endActor, context );
+            }
+            context.checkActor( curActor );
 
-        //pop the curActor from the queue, set it as visited
-        curActor = actorQueue.top(); actorQueue.pop();
-        if( curActor->name == actorEnd ) { break; }
-        if( curActor->checked == true ) { continue; }
-        curActor->checked = true;
-        
-        //go through each movie and add the actors to the queue
-        for( unsigned int i = 0; i < curActor->movies.size(); i++ ) {
+            const uint32_t* movieEnd = csr.moviesEnd( curActor );
+            for( const uint32_t* movie = csr.moviesBegin( curActor );
+                 movie != movieEnd; movie++ ) {
 
-            MovieNode* curMov = curActor->movies.at(i);
-            if( curMov->checked == true ) { continue; }
-            
-            //add the actors in the movies to the queue
-            for( unsigned int j = 0; j < curMov->actors.size(); j++ ) {
-                
-                tmpActor= curMov->actors.at(j);
-                unsigned int totalDist = curActor->dist + curMov->weight;
-                if( totalDist < tmpActor->dist ) {
-                    tmpActor->dist = totalDist;
-                    tmpActor->previous = curMov;
-                    actorQueue.push( tmpActor );
-                    actorCleanup.push_back( tmpActor );
+                if( context.isMovieChecked( *movie ) &&
+                    context.actorDist[context.moviePrevious[*movie]] <=
+                        curDist ) {
+                    continue;
                 }
-            
+                context.checkMovie( *movie, curActor );
+
+                unsigned int totalDist = curDist + csr.movieWeights[*movie];
+                const uint32_t* actorEnd = csr.actorsEnd( *movie );
+                for( const uint32_t* actor = csr.actorsBegin( *movie );
+                     actor != actorEnd; actor++ ) {
+                    if( totalDist >= context.dist( *actor ) ) { continue; }
+                    //the bound of an actor only has to be found once
+                    if( !context.isActorSeen( *actor ) ) {
+                        context.seeActor( *actor );
+                        context.actorBound[*actor] =
+                            landmarks.bound( *actor, endActor );
+                    }
+                    context.actorDist[*actor] = totalDist;
+                    context.actorPrevious[*actor] = *movie;
+                    unsigned int key = totalDist + context.actorBound[*actor];
+                    buckets[key % numBuckets].push_back( *actor );
+                    numQueued++;
+                }
+
             }
-            
-            //set the previous actor and the checked to 1
-            curMov->previous = curActor;
-            curMov->checked = true;
-            movieCleanup.push_back( curMov );
 
         }
+        bucket.clear();
 
     }
 
-    //check to see if we even found the node at all
-    if( curActor == 0 || curActor->name != actorEnd ) {
-        //clean up the actor nodes and movie nodes
-        for( unsigned int i = 0; i < actorCleanup.size(); i++ ) {
-            actorCleanup[i]->previous = 0;
-            actorCleanup[i]->checked = false;
-            actorCleanup[i]->dist = (unsigned)-1;
-        }
-        for( unsigned int i = 0; i < movieCleanup.size(); i++ ) {
-            movieCleanup[i]->previous = 0;
-            movieCleanup[i]->checked = false;
-        }
-        return "";
-    }
-    
-    //backtrack to the start node and add each actor and movie to a stack
-    stack<pair<ActorNode*,MovieNode*>> actorOrder = 
-        std::stack<std::pair<ActorNode*,MovieNode*>>();
-    while( curActor->previous != 0 ) {
-    
-        MovieNode* movieEdge = curActor->previous;
-        //add the node and edge to a pair and to the stack
-        pair<ActorNode*,MovieNode*> stackPair = 
-            std::pair<ActorNode*,MovieNode*>( curActor, movieEdge );
-        actorOrder.push( stackPair );
-        curActor = curActor->previous->previous;
+    return "";
 
-    }
-    
-    //start with the curNode which should be the starting actor
-    string outStr = "(" + curActor->name + ")";
-    //go through each pair in the stack and add it to the string
-    while( !actorOrder.empty() ) {
+}
 
-        string actorName = actorOrder.top().first->name;
-        string movieName = actorOrder.top().second->name;
-        string movieYear = to_string(actorOrder.top().second->year);
-        string formatStr = "--[" + movieName + "#@" + movieYear + 
-                           "]-->(" + actorName + ")";
-        outStr += formatStr;
-        actorOrder.pop();
 
+/* Moves the best numBest actors of a list to its front in sorted order.
+ * The rest of the list is only split off from them by nth_element and
+ * left unsorted.
+ * Parameter: actors - the list of actor ids to sort the front of
+ * Parameter: numBest - the number of actors to sort
+ * Parameter: compareLinks - the order of the actors, best first
+ */
+static void sortBest( vector<uint32_t>& actors, size_t numBest,
+                      const CompareLinks& compareLinks ) {
+    if( numBest < actors.size() ) {
+        std::nth_element( actors.begin(), actors.begin() + numBest,
+                          actors.end(), compareLinks );
+        actors.resize( numBest );
     }
-    
-    //clean up the actor nodes and movie nodes
-    for( unsigned int i = 0; i < actorCleanup.size(); i++ ) {
-        actorCleanup[i]->previous = 0;
-        actorCleanup[i]->checked = false;
-        actorCleanup[i]->dist = (unsigned)-1;
-    }
-    for( unsigned int i = 0; i < movieCleanup.size(); i++ ) {
-        movieCleanup[i]->previous = 0;
-        movieCleanup[i]->checked = false;
-    }
-
-    //return the string
-    return outStr;
-
+    std::sort( actors.begin(), actors.end(), compareLinks );
 }
 
 /**
@@ -359,57 +2131,84 @@ string ActorGraph::findWeightedActors(string actorStart, string actorEnd) {
  * actors that have worked on the same movies as the input actor and makes
  * a sorted list of actors that have direclty collaborated and have not.
  * These two lists, directly collaborated and haven't collaborated, are
- * returned in a pair.
+ * returned in a pair, each cut down to the numLinks best actors.
+ * Parameter: actor - the actor which we want to find all of the links of
+ * Parameter: numLinks - the most actors to return in each list
+ */
+pair<vector<string>, vector<string>> 
+    ActorGraph::getPredictedLinks( string actor, unsigned int numLinks ) {
+    return getPredictedLinks( actor, defaultContext, numLinks );
+}
+
+/**
+ * This method is the link prediction of getPredictedLinks, keeping all of
+ * its state in the given context instead of the graph. Only the best
+ * numLinks actors of each list are ever sorted, the rest are just split
+ * off from them, since a prolific actor can have hundreds of thousands of
+ * actors in the second list.
  * Parameter: actor - the actor which we want to find all of the links of
+ * Parameter: context - the search state, one per thread searching
+ * Parameter: numLinks - the most actors to return in each list
  */
 pair<vector<string>, vector<string>> 
-    ActorGraph::getPredictedLinks( string actor ) {
+    ActorGraph::getPredictedLinks( const string& actor,
+                                   QueryContext& context,
+                                   unsigned int numLinks ) const {
     
-    //check to see if the actor isn't in the map, return empty arrays if so
-    if( actorMap.find( actor ) == actorMap.end() ) {
+    //check to see if the actor isn't in the graph, return empty arrays if so
+    ActorNode* actorNode = findActor( actor );
+    if( actorNode == 0 ) {
         vector<string> noStr = std::vector<string>();
         return pair<vector<string>, vector<string>>(noStr, noStr);
     }
+    context.begin( csr.numActors(), csr.numMovies() );
     
-    vector<ActorNode*> collabActors = std::vector<ActorNode*>();
-    vector<ActorNode*> futureActors = std::vector<ActorNode*>();
-    vector<MovieNode*> movieCleanup = std::vector<MovieNode*>();
+    vector<uint32_t> collabActors = std::vector<uint32_t>();
+    vector<uint32_t> futureActors = std::vector<uint32_t>();
     //loop through all of the actors immediately connected to the given actor
-    ActorNode* actorNode = actorMap.find( actor )->second;
-    actorNode->checked = true;
-    for( unsigned int i = 0; i < actorNode->movies.size(); i++ ) {
-        MovieNode* movieNode = actorNode->movies.at(i);
-        for( unsigned int j = 0; j < movieNode->actors.size(); j++ ) {
-            ActorNode* tmp = movieNode->actors.at(j);
-            if( tmp->links == 0 ) {
-                collabActors.push_back( tmp );
+    context.seeActor( actorNode->id );
+    context.checkActor( actorNode->id );
+    const uint32_t* movieEnd = csr.moviesEnd( actorNode->id );
+    for( const uint32_t* movie = csr.moviesBegin( actorNode->id );
+         movie != movieEnd; movie++ ) {
+        const uint32_t* actorEnd = csr.actorsEnd( *movie );
+        for( const uint32_t* tmp = csr.actorsBegin( *movie );
+             tmp != actorEnd; tmp++ ) {
+            if( context.links( *tmp ) == 0 ) {
+                collabActors.push_back( *tmp );
+                context.seeActor( *tmp );
             }
-            tmp->checked = true;
-            tmp->links++;
+            context.checkActor( *tmp );
+            context.actorLinks[*tmp]++;
         }
     }
 
-    //sort the list of actor nodes
-    std::sort( collabActors.begin(), collabActors.end(), CompareLinks() );
-    
+    //the links of the second list add up the same whatever order the first
+    //list is in, so neither list is sorted until both are full
+    CompareLinks compareLinks = { context, actorList };
+
     //loop through all of the first generation actors
     for( unsigned int i = 0; i < collabActors.size(); i++ ) {
 
-        ActorNode* curActor = collabActors[i];
+        uint32_t curActor = collabActors[i];
+        unsigned int curLinks = context.actorLinks[curActor];
         //loop through each movie in curActor
-        for( unsigned int j = 0; j < curActor->movies.size(); j++ ) {
+        const uint32_t* movieEnd = csr.moviesEnd( curActor );
+        for( const uint32_t* movie = csr.moviesBegin( curActor );
+             movie != movieEnd; movie++ ) {
 
-            MovieNode* movieNode = curActor->movies.at(j);
             //loop through each actor for each movie for each first gen actor
-            for( unsigned int k = 0; k < movieNode->actors.size(); k++ ) {
+            const uint32_t* actorEnd = csr.actorsEnd( *movie );
+            for( const uint32_t* tmp = csr.actorsBegin( *movie );
+                 tmp != actorEnd; tmp++ ) {
     
-                ActorNode* tmp = movieNode->actors.at(k);
-                if( tmp->checked ) { continue; }
-                if( tmp->links == 0 ) {
-                    futureActors.push_back( tmp );
+                if( context.isActorChecked( *tmp ) ) { continue; }
+                if( context.links( *tmp ) == 0 ) {
+                    futureActors.push_back( *tmp );
+                    context.seeActor( *tmp );
                 }
                 //instead of adding by one, add by cur actor # links
-                tmp->links += curActor->links;
+                context.actorLinks[*tmp] += curLinks;
 
             }
 
@@ -417,134 +2216,594 @@ pair<vector<string>, vector<string>>
 
     } // end add future actors links
 
-    //sort the second list
-    std::sort( futureActors.begin(), futureActors.end(), CompareLinks() );
+    //sort the best actors of both lists
+    sortBest( collabActors, numLinks, compareLinks );
+    sortBest( futureActors, numLinks, compareLinks );
     
     //add the string vectors in order to return
     vector<string> collabStr = std::vector<string>();
     vector<string> futureStr = std::vector<string>();
 
     //add the actor names from the list to a vector
-    for( unsigned int i = 0; i < 4; i++ ) {
+    for( unsigned int i = 0; i < numLinks; i++ ) {
         if( i < collabActors.size() ) {
-            collabStr.push_back( collabActors[i]->name );
+            collabStr.emplace_back( actorList[collabActors[i]]->name );
         }
         if( i < futureActors.size() ) {
-            futureStr.push_back( futureActors[i]->name );
+            futureStr.emplace_back( actorList[futureActors[i]]->name );
         }
     }
 
-    //reset all the values that we've changed
-    actorNode->checked = false;
-    for( unsigned int i = 0; i < collabActors.size(); i++ ) {
-        collabActors[i]->links = 0;
-        collabActors[i]->checked = false;
+    return std::pair<vector<string>,vector<string>>( collabStr, futureStr );
+
+}
+
+/**
+ * This method builds the contraction hierarchy of the graph for
+ * findWeightedActorsCH, replacing any hierarchy from before. It has to be
+ * built again whenever the graph changes.
+ */
+void ActorGraph::buildHierarchy() {
+    hierarchy.build( csr );
+}
+
+/**
+ * This method finds the same kind of path as findWeightedActors with a
+ * search of the contraction hierarchy. When there are several lightest
+ * paths it may return a different one than findWeightedActors.
+ * Parameter: actorStart - the starting actor in the actor/movie chain
+ * Parameter: actorEnd - the ending actor in the actor/movie chain
+ */
+string ActorGraph::findWeightedActorsCH(string actorStart, string actorEnd) {
+    return findWeightedActorsCH( actorStart, actorEnd, defaultContext );
+}
+
+/**
+ * This method is the contraction hierarchy search of findWeightedActorsCH,
+ * keeping all of its state in the given context instead of the graph.
+ * Parameter: actorStart - the starting actor in the actor/movie chain
+ * Parameter: actorEnd - the ending actor in the actor/movie chain
+ * Parameter: context - the search state, one per thread searching
+ */
+string ActorGraph::findWeightedActorsCH( const string& actorStart,
+                                         const string& actorEnd,
+                                         QueryContext& context ) const {
+
+    ActorNode* startNode = findActor( actorStart );
+    ActorNode* endNode = findActor( actorEnd );
+    if( startNode == 0 || endNode == 0 ) { return ""; }
+    return weightedPathCH( startNode->id, endNode->id, context );
+
+}
+
+/**
+ * This method does the search of findWeightedActorsCH. Dijkstra's algorithm
+ * runs from both actors at once, always going on with the side whose next
+ * node is closer, and only ever follows edges up in rank or inside the
+ * core, where it is a plain bidirectional search. Every node both
+ * sides reach is a way through, and a side stops once the next node it
+ * would take is no closer than the lightest way through so far. The edges
+ * of the path found are then unpacked back into actors and movies. Without
+ * a hierarchy the path is found with the bucket queue search instead.
+ * Parameter: startActor - the id of the actor the search starts at
+ * Parameter: endActor - the id of the actor the search is looking for
+ * Parameter: context - the search state, one per thread searching
+ */
+string ActorGraph::weightedPathCH( uint32_t startActor, uint32_t endActor,
+                                   QueryContext& context ) const {
+
+    if( !hierarchy.covers( csr.numActors(), csr.numMovies() ) ) {
+        vector<string> results = std::vector<string>( 1 );
+        vector<PathTarget> targets =
+            std::vector<PathTarget>( 1, PathTarget{ endActor, 0 } );
+        weightedFromDial( startActor, targets, results, context );
+        return results[0];
+    }
+    context.beginNodes( csr.numActors(), csr.numMovies() );
+
+    //the queues hold (distance, node) pairs
+    priority_queue<pair<unsigned int, uint32_t>,
+                   vector<pair<unsigned int, uint32_t>>,
+                   greater<pair<unsigned int, uint32_t>>> queues[2] = {
+        std::priority_queue<pair<unsigned int, uint32_t>,
+                            vector<pair<unsigned int, uint32_t>>,
+                            greater<pair<unsigned int, uint32_t>>>(),
+        std::priority_queue<pair<unsigned int, uint32_t>,
+                            vector<pair<unsigned int, uint32_t>>,
+                            greater<pair<unsigned int, uint32_t>>>() };
+    context.reachNode( startActor, 0, NO_ID );
+    context.reachNodeBack( endActor, 0, NO_ID );
+    queues[0].push( pair<unsigned int, uint32_t>( 0, startActor ) );
+    queues[1].push( pair<unsigned int, uint32_t>( 0, endActor ) );
+
+    unsigned int bestDist = (unsigned)-1;
+    uint32_t meetNode = NO_ID;
+    while( true ) {
+
+        //a side is done once nothing left in it can make the path lighter
+        bool startDone = queues[0].empty() || queues[0].top().first >= bestDist;
+        bool endDone = queues[1].empty() || queues[1].top().first >= bestDist;
+        if( startDone && endDone ) { break; }
+        bool fromStart = !startDone &&
+            ( endDone || queues[0].top().first <= queues[1].top().first );
+
+        unsigned int curDist = queues[!fromStart].top().first;
+        uint32_t curNode = queues[!fromStart].top().second;
+        queues[!fromStart].pop();
+        unsigned int sideDist = fromStart ? context.distOfNode( curNode )
+                                          : context.distOfNodeBack( curNode );
+        if( curDist != sideDist ) { continue; }
+
+        unsigned int otherDist = fromStart
+                                     ? context.distOfNodeBack( curNode )
+                                     : context.distOfNode( curNode );
+        if( otherDist != (unsigned)-1 && curDist + otherDist < bestDist ) {
+            bestDist = curDist + otherDist;
+            meetNode = curNode;
+        }
+
+        for( uint32_t i = hierarchy.upOffsets[curNode];
+             i < hierarchy.upOffsets[curNode + 1]; i++ ) {
+            uint32_t next = hierarchy.upTargets[i];
+            unsigned int totalDist = curDist + hierarchy.upWeights[i];
+            if( fromStart ) {
+                if( totalDist >= context.distOfNode( next ) ) { continue; }
+                context.reachNode( next, totalDist, curNode );
+            } else {
+                if( totalDist >= context.distOfNodeBack( next ) ) { continue; }
+                context.reachNodeBack( next, totalDist, curNode );
+            }
+            queues[!fromStart].push(
+                pair<unsigned int, uint32_t>( totalDist, next ) );
+        }
+
     }
-    for( unsigned int i = 0; i < futureActors.size(); i++ ) {
-        futureActors[i]->links = 0;
-        futureActors[i]->checked = false;
+    if( meetNode == NO_ID ) { return ""; }
+
+    //the upward nodes from the start to where the sides met, and then the
+    //ones down to the end, with every shortcut between them unpacked
+    vector<uint32_t> upNodes = std::vector<uint32_t>();
+    for( uint32_t node = meetNode; node != NO_ID;
+         node = context.nodePrevious[node] ) {
+        upNodes.push_back( node );
+    }
+    std::reverse( upNodes.begin(), upNodes.end() );
+    vector<uint32_t> path = std::vector<uint32_t>( 1, startActor );
+    for( size_t i = 1; i < upNodes.size(); i++ ) {
+        hierarchy.unpack( upNodes[i - 1], upNodes[i], path );
+    }
+    for( uint32_t node = meetNode; context.nodeNext[node] != NO_ID;
+         node = context.nodeNext[node] ) {
+        hierarchy.unpack( node, context.nodeNext[node], path );
     }
 
-    return std::pair<vector<string>,vector<string>>( collabStr, futureStr );
+    //the path goes back and forth between actors and movies
+    uint32_t numActors = csr.numActors();
+    string outStr = pathStart( actorList[path[0]]->name );
+    for( size_t i = 1; i + 1 < path.size(); i += 2 ) {
+        appendStep( outStr, movieList[path[i] - numActors],
+                    actorList[path[i + 1]]->name );
+    }
+    return outStr;
+
+}
+
+/* Writes every line to out, each followed by a newline
+ * Parameter: out - the stream the lines are written to
+ * Parameter: lines - the lines to write
+ */
+static void writeLines( ostream& out, const vector<string>& lines ) {
+    for( size_t i = 0; i < lines.size(); i++ ) {
+        out << lines[i] << '\n';
+    }
+}
+
+/**
+ * This function uses Kruskal's algorithm along with the UnionFind
+ * datastructure in order to create the smallest spanning tree of every
+ * connected group of actors. This program will output a vector of the
+ * strings expected to be printed out.
+ */
+vector<string> ActorGraph::findSmallestTree() const {
+    vector<ForestEdge> treeEdges = std::vector<ForestEdge>();
+    smallestTreeEdges( [&treeEdges]( const ForestEdge& edge ) {
+        treeEdges.push_back( edge );
+    } );
+    return formatTree( treeEdges );
+}
 
+/**
+ * This function writes the lines of findSmallestTree to out as each edge
+ * is chosen instead of keeping them, so only the graph and the UnionFind
+ * are ever in memory no matter how big the forest is.
+ * Parameter: out - the stream the lines are written to
+ */
+void ActorGraph::writeSmallestTree( ostream& out ) const {
+    size_t numEdges = 0;
+    unsigned int numWeights = 0;
+    smallestTreeEdges( [&]( const ForestEdge& edge ) {
+        out << formatEdge( edge ) << '\n';
+        numEdges++;
+        numWeights += movieList[edge.movie]->weight;
+    } );
+    writeLines( out, treeTotals( numEdges, numWeights ) );
 }
 
 /**
-  * This function uses Kruskal's algorithm along with the UnionFind
-  * datastructure in order to create the smallest spanning tree given
-  * a connected graph. This program will output a vector of the
-  * strings expected to be printed out.
-  */
-vector<string> ActorGraph::findSmallestTree() {
+ * This method is Kruskal's algorithm for findSmallestTree. The movies are
+ * put in order of weight by a counting sort and gone through once, and
+ * each movie joins the rest of its cast to its first actor, which picks
+ * the same edges as trying every pair of the cast. Every edge is handed to
+ * visit as soon as it is chosen.
+ * Parameter: visit - called with every edge of the forest in order
+ */
+void ActorGraph::smallestTreeEdges(
+    const function<void(const ForestEdge&)>& visit ) const {
     
-    //create a forest along with an ordered set of edges
-    unordered_set<ActorNode*> forest = unordered_set<ActorNode*>();
-    auto actorMapIter = actorMap.begin();
-    while( actorMapIter != actorMap.end() ) {
-        forest.insert( actorMapIter->second );
-        actorMapIter++;
-    }
-    vector<MovieNode*> edges = std::vector<MovieNode*>();
-    auto movieMapIter = movieMap.begin();
-    while( movieMapIter != movieMap.end() ) {
-        edges.push_back( movieMapIter->second );
-        movieMapIter++;
-    }
-    std::sort( edges.begin(), edges.end(), CompareWeight() );
-    UnionFind unionFind = UnionFind();
-    //create a set to store all of the MovieNodes that have been effected
-    unordered_set<MovieNode*> treeEdge = std::unordered_set<MovieNode*>(); 
-    unsigned int numEdges = 0; unsigned int numWeights = 0;
+    //put the movies in order of weight, ties stay in order of id
+    uint32_t numMovies = csr.numMovies();
+    vector<uint32_t> edges = std::vector<uint32_t>( numMovies );
+    if( csr.maxWeight < MAX_DIST_BUCKETS ) {
+        vector<uint32_t> starts =
+            std::vector<uint32_t>( csr.maxWeight + 2, 0 );
+        for( uint32_t i = 0; i < numMovies; i++ ) {
+            starts[csr.movieWeights[i] + 1]++;
+        }
+        for( size_t w = 1; w < starts.size(); w++ ) {
+            starts[w] += starts[w - 1];
+        }
+        for( uint32_t i = 0; i < numMovies; i++ ) {
+            edges[starts[csr.movieWeights[i]]++] = i;
+        }
+    } else {
+        //a graph with very heavy movies would need too many buckets
+        for( uint32_t i = 0; i < numMovies; i++ ) { edges[i] = i; }
+        std::stable_sort( edges.begin(), edges.end(),
+            [this]( uint32_t m1, uint32_t m2 ) {
+                return csr.movieWeights[m1] < csr.movieWeights[m2];
+            } );
+    }
+
+    //every actor starts as a tree of its own
+    UnionFind unionFind = UnionFind( actorList.size() );
 
     //go trough the edges from smallest to largest weight
-    while( forest.size() > 1 ) {
-        
-        //get the lowest weighted edge
-        for( unsigned int i = 0; i < edges.size(); i++ ) {
-            
-            MovieNode* curEdge = edges[i];
-
-            //get two actors from the edge and check if they work
-            for( unsigned int j = 0; j < curEdge->actors.size(); j++ ) {
-                ActorNode* actor1 = curEdge->actors.at(j);
-                for( unsigned int k = j; k < curEdge->actors.size(); k++ ) {
-
-                    ActorNode* actor2 = curEdge->actors.at(k);
-                    if( unionFind.find(actor1) != unionFind.find(actor2) ) {
-
-                        forest.erase( actor1 );
-                        forest.erase( actor2 );
-                        ActorNode* root = unionFind.unite( actor1, actor2 );
-                        forest.insert( root );
-                        curEdge->actorPairs.push_back( 
-                            pair<ActorNode*, ActorNode*>( actor1, actor2 ));
-                        if( treeEdge.find( curEdge ) == treeEdge.end() ) {
-                            treeEdge.insert( curEdge );
-                        }
-                        numEdges++;
-                        numWeights += curEdge->weight;
+    for( uint32_t i = 0; i < numMovies && unionFind.count() > 1; i++ ) {
+
+        uint32_t curEdge = edges[i];
+        const uint32_t* cast = csr.actorsBegin( curEdge );
+        uint32_t castSize = csr.numActorsOf( curEdge );
+        for( uint32_t k = 1; k < castSize && unionFind.count() > 1; k++ ) {
+            if( unionFind.unite( cast[0], cast[k] ) ) {
+                visit( ForestEdge{ curEdge, k, cast[0], cast[k] } );
+            }
+        }
 
-                    }
+    }
+
+}
+
+/* The edges a Boruvka round has left, the key of an edge is the weight of
+ * its movie and then the place of actor2 in the credits of the movies */
+struct TreeEdge {
+    uint64_t key;
+    uint32_t actor1;
+    uint32_t actor2;
+};
+
+//the best edge of a tree that has no edges out of it
+static const uint64_t NO_TREE_EDGE = UINT64_MAX;
+
+/* Lowers the best edge of a tree to key if key is smaller, while other
+ * threads may be lowering it too
+ * Parameter: best - the key of the best edge of the tree so far
+ * Parameter: key - the key of an edge out of the tree
+ */
+static void lowerBestEdge( atomic<uint64_t>& best, uint64_t key ) {
+    uint64_t curKey = best.load( memory_order_relaxed );
+    while( key < curKey &&
+           !best.compare_exchange_weak( curKey, key,
+                                        memory_order_relaxed ) ) {}
+}
+
+/* Holds the threads of a Boruvka search together between its steps. Every
+ * thread waits at the barrier until all of them have got there, and each
+ * one can vote on whether the search goes on.
+ */
+class StepBarrier {
+
+  private:
+
+    mutex lock;
+    condition_variable allThere;
+    //the number of threads, and how many are waiting
+    unsigned int numThreads;
+    unsigned int numWaiting;
+    //the number of times every thread has got to the barrier
+    unsigned int generation;
+    //whether any thread voted yes this time, and the last time
+    bool votes;
+    bool result;
+
+  public:
+
+    /* Constructor for a barrier of numThreads threads
+     * Parameter: numThreads - the number of threads that wait at it
+     */
+    StepBarrier( unsigned int numThreads )
+        : numThreads(numThreads), numWaiting(0), generation(0),
+          votes(false), result(false) {}
+
+    /* Waits until every thread has got to the barrier
+     * Parameter: vote - whether this thread wants the search to go on
+     * Returns: true if any of the threads voted to go on
+     */
+    bool wait( bool vote ) {
+
+        unique_lock<mutex> guard( lock );
+        votes = votes || vote;
+        if( ++numWaiting == numThreads ) {
+            result = votes;
+            votes = false;
+            numWaiting = 0;
+            generation++;
+            allThere.notify_all();
+            return result;
+        }
+        //the result stays until every thread is back at the barrier
+        unsigned int curGeneration = generation;
+        allThere.wait( guard, [&]() { return generation != curGeneration; } );
+        return result;
+
+    }
+
+};
 
-                    if( forest.size() <= 1 ) { break; }
+/**
+ * This function finds the same trees as findSmallestTree with Boruvka's
+ * algorithm on numThreads threads.
+ * Parameter: numThreads - the number of threads, 0 for all cores
+ */
+vector<string> ActorGraph::findSmallestTreeBoruvka(
+    unsigned int numThreads ) const {
+    vector<ForestEdge> treeEdges = std::vector<ForestEdge>();
+    boruvkaTreeEdges( numThreads, [&treeEdges]( const ForestEdge& edge ) {
+        treeEdges.push_back( edge );
+    } );
+    return formatTree( treeEdges );
+}
+
+/**
+ * This function writes the lines of findSmallestTreeBoruvka to out as the
+ * edges are put in order instead of keeping them as lines.
+ * Parameter: out - the stream the lines are written to
+ * Parameter: numThreads - the number of threads, 0 for all cores
+ */
+void ActorGraph::writeSmallestTreeBoruvka( ostream& out,
+                                          unsigned int numThreads ) const {
+    size_t numEdges = 0;
+    unsigned int numWeights = 0;
+    boruvkaTreeEdges( numThreads, [&]( const ForestEdge& edge ) {
+        out << formatEdge( edge ) << '\n';
+        numEdges++;
+        numWeights += movieList[edge.movie]->weight;
+    } );
+    writeLines( out, treeTotals( numEdges, numWeights ) );
+}
 
+/**
+ * This method is Boruvka's algorithm for findSmallestTreeBoruvka. The
+ * edges of the star of every movie are split between the threads by movie,
+ * and the actors by id, and the same threads run every round. In a round
+ * each thread drops its edges that are inside one tree and offers the rest
+ * as the best edge out of the trees on both of their ends. Then every tree
+ * hooks onto the tree at the other end of its best edge, the hooks are
+ * followed by pointer jumping until every tree points at the root of its
+ * new tree, and every actor takes that root. Each of these steps only
+ * writes the entries of the thread's own actors. A round at least halves
+ * the number of trees. The keys of the edges are all different and ordered
+ * the same way Kruskal's algorithm takes the edges, so both pick the same
+ * edges, which are put back in that order before they are handed to visit.
+ * Parameter: numThreads - the number of threads, 0 for all cores
+ * Parameter: visit - called with every edge of the forest in order
+ */
+void ActorGraph::boruvkaTreeEdges( unsigned int numThreads,
+    const function<void(const ForestEdge&)>& visit ) const {
+
+    uint32_t numActors = csr.numActors();
+    uint32_t numMovies = csr.numMovies();
+    //there is no point in more threads than movies
+    if( numThreads == 0 ) { numThreads = thread::hardware_concurrency(); }
+    if( numThreads > numMovies ) { numThreads = numMovies; }
+    if( numThreads == 0 ) { numThreads = 1; }
+
+    //every thread gets a run of movies with about as many credits as the rest
+    vector<uint32_t> firstMovie = std::vector<uint32_t>( numThreads + 1 );
+    for( unsigned int t = 0; t < numThreads; t++ ) {
+        uint32_t credit = (uint32_t)( (uint64_t)csr.numCredits() * t /
+                                      numThreads );
+        firstMovie[t] = std::lower_bound( csr.movieOffsets.begin(),
+                                          csr.movieOffsets.end() - 1,
+                                          credit ) - csr.movieOffsets.begin();
+    }
+    firstMovie[numThreads] = numMovies;
+
+    //the tree of every actor as of the last round and the best edge out of
+    //every tree in this round, a tree is known by the id of its root
+    vector<uint32_t> trees = std::vector<uint32_t>( numActors );
+    vector<atomic<uint64_t>> best = std::vector<atomic<uint64_t>>( numActors );
+    for( uint32_t i = 0; i < numActors; i++ ) {
+        trees[i] = i;
+        best[i].store( NO_TREE_EDGE, memory_order_relaxed );
+    }
+    //the tree every tree hooks onto, and the same after pointer jumping,
+    //only the entries of the roots of the last round are used
+    vector<uint32_t> hooks = std::vector<uint32_t>( numActors );
+    vector<uint32_t> jumped = std::vector<uint32_t>( numActors );
+    //the star edges each thread has left and the edges each thread chose
+    vector<vector<TreeEdge>> edges =
+        std::vector<vector<TreeEdge>>( numThreads );
+    vector<vector<uint64_t>> treeKeys =
+        std::vector<vector<uint64_t>>( numThreads );
+    StepBarrier barrier = StepBarrier( numThreads );
+
+    auto work = [&]( unsigned int t ) {
+
+        //each thread lists the star edges of its movies
+        vector<TreeEdge>& mine = edges[t];
+        for( uint32_t movie = firstMovie[t]; movie < firstMovie[t + 1];
+             movie++ ) {
+            uint32_t first = csr.movieOffsets[movie];
+            uint64_t weight = (uint64_t)csr.movieWeights[movie] << 32;
+            for( uint32_t i = first + 1; i < csr.movieOffsets[movie + 1];
+                 i++ ) {
+                mine.push_back( TreeEdge{ weight | i,
+                    csr.movieActors[first], csr.movieActors[i] } );
+            }
+        }
+        uint32_t firstActor = (uint32_t)( (uint64_t)numActors * t /
+                                          numThreads );
+        uint32_t lastActor = (uint32_t)( (uint64_t)numActors * ( t + 1 ) /
+                                         numThreads );
+
+        while( true ) {
+
+            //offer the edges that still join two trees
+            size_t numKept = 0;
+            for( size_t i = 0; i < mine.size(); i++ ) {
+                uint32_t tree1 = trees[mine[i].actor1];
+                uint32_t tree2 = trees[mine[i].actor2];
+                if( tree1 == tree2 ) { continue; }
+                mine[numKept++] = mine[i];
+                lowerBestEdge( best[tree1], mine[i].key );
+                lowerBestEdge( best[tree2], mine[i].key );
+            }
+            mine.resize( numKept );
+            barrier.wait( false );
+
+            //every tree hooks onto the tree at the other end of its best
+            //edge, and two trees with the same best edge onto the smaller
+            bool hooked = false;
+            for( uint32_t i = firstActor; i < lastActor; i++ ) {
+                if( trees[i] != i ) { continue; }
+                hooks[i] = i;
+                uint64_t key = best[i].load( memory_order_relaxed );
+                if( key == NO_TREE_EDGE ) { continue; }
+                uint32_t credit = (uint32_t)key;
+                uint32_t movie = std::upper_bound( csr.movieOffsets.begin(),
+                    csr.movieOffsets.end(), credit ) -
+                    csr.movieOffsets.begin() - 1;
+                uint32_t other =
+                    trees[csr.movieActors[csr.movieOffsets[movie]]];
+                if( other == i ) { other = trees[csr.movieActors[credit]]; }
+                if( i < other &&
+                    best[other].load( memory_order_relaxed ) == key ) {
+                    continue;
                 }
-                
-                if( forest.size() <= 1 ) { break; }
-            
-            } 
+                hooks[i] = other;
+                treeKeys[t].push_back( key );
+                hooked = true;
+            }
+            //no tree hooked onto another, so the forest is done
+            if( !barrier.wait( hooked ) ) { break; }
+
+            //jump every tree to the tree its tree hooks onto until they all
+            //point at a root, the arrays read in a step are not written
+            vector<uint32_t>* from = &hooks;
+            vector<uint32_t>* to = &jumped;
+            bool moved = true;
+            while( moved ) {
+                moved = false;
+                for( uint32_t i = firstActor; i < lastActor; i++ ) {
+                    if( trees[i] != i ) { continue; }
+                    (*to)[i] = (*from)[(*from)[i]];
+                    moved = moved || (*to)[i] != (*from)[i];
+                }
+                moved = barrier.wait( moved );
+                std::swap( from, to );
+            }
 
-            if( forest.size() <= 1 ) { break; }
+            //every actor takes the root its tree ends up under
+            for( uint32_t i = firstActor; i < lastActor; i++ ) {
+                if( trees[i] == i ) {
+                    best[i].store( NO_TREE_EDGE, memory_order_relaxed );
+                }
+                trees[i] = (*from)[trees[i]];
+            }
+            barrier.wait( false );
 
         }
-        
-        if( forest.size() <= 1 ) { break; }
 
-    } // end while
+    };
 
-    //now we have the tree, print out the movie nodes connected to it
-    vector<string> outVector = std::vector<string>();
-    auto edgeIter = treeEdge.begin();
-    while( edgeIter != treeEdge.end() ) {
-    
-        //derefencing iter gives movie node pointer
-        MovieNode* curEdge = *edgeIter;
-        for( unsigned int j = 0; j < curEdge->actorPairs.size(); j++ ) {
+    vector<thread> workers = std::vector<thread>();
+    for( unsigned int t = 1; t < numThreads; t++ ) {
+        workers.emplace_back( work, t );
+    }
+    work( 0 );
+    for( unsigned int t = 0; t < workers.size(); t++ ) {
+        workers[t].join();
+    }
+
+    //put the edges in the order Kruskal's algorithm would have taken them
+    vector<uint64_t> allKeys = std::vector<uint64_t>();
+    for( unsigned int t = 0; t < numThreads; t++ ) {
+        allKeys.insert( allKeys.end(), treeKeys[t].begin(),
+                        treeKeys[t].end() );
+    }
+    std::sort( allKeys.begin(), allKeys.end() );
+    for( size_t i = 0; i < allKeys.size(); i++ ) {
+        uint32_t credit = (uint32_t)allKeys[i];
+        uint32_t movie = std::upper_bound( csr.movieOffsets.begin(),
+            csr.movieOffsets.end(), credit ) - csr.movieOffsets.begin() - 1;
+        uint32_t first = csr.movieOffsets[movie];
+        visit( ForestEdge{ movie, credit - first,
+                           csr.movieActors[first], csr.movieActors[credit] } );
+    }
 
-            ActorNode* actor1 = curEdge->actorPairs.at(j).first;
-            ActorNode* actor2 = curEdge->actorPairs.at(j).second;
-            string outstr = "(" + actor1->name + ")<--[" + curEdge->name +
-                            "#@" + to_string(curEdge->year) + "]-->(" + 
-                            actor2->name + ")";
-            outVector.push_back( outstr );
+}
 
-        }
-        edgeIter++;
+/**
+ * This method makes the lines printed for a forest of movie trees, one for
+ * every edge in order and then the number of actors, trees, edges and the
+ * total weight of the edges.
+ * Parameter: treeEdges - every edge of the forest
+ */
+vector<string> ActorGraph::formatTree(
+    const vector<ForestEdge>& treeEdges ) const {
 
+    //now we have the forest, print out the movie nodes connected to it
+    vector<string> outVector = std::vector<string>();
+    outVector.reserve( treeEdges.size() + 4 );
+    unsigned int numWeights = 0;
+    for( size_t i = 0; i < treeEdges.size(); i++ ) {
+        outVector.push_back( formatEdge( treeEdges[i] ) );
+        numWeights += movieList[treeEdges[i].movie]->weight;
     }
+    vector<string> totals = treeTotals( treeEdges.size(), numWeights );
+    outVector.insert( outVector.end(), totals.begin(), totals.end() );
+
+    return outVector;
+
+}
+
+/**
+ * This method makes the lines printed after the edges of a forest of movie
+ * trees, the number of actors, trees, edges and the total weight.
+ * Parameter: numEdges - the number of edges in the forest
+ * Parameter: numWeights - the weight of every edge added together
+ */
+vector<string> ActorGraph::treeTotals( size_t numEdges,
+                                       unsigned int numWeights ) const {
 
-    string nodeStr = "#NODE CONNECTED: " + to_string((*forest.begin())->size);
+    //every actor is in the tree of its group
+    vector<string> outVector = std::vector<string>();
+    string nodeStr = "#NODE CONNECTED: " + to_string( actorList.size() );
     outVector.push_back( nodeStr );
+    size_t numTrees = actorList.size() - numEdges;
+    if( numTrees > 1 ) {
+        outVector.push_back( "#TREES IN FOREST: " + to_string( numTrees ) );
+    }
     string edgeStr = "#EDGE CHOSEN: " + to_string( numEdges );
     outVector.push_back( edgeStr );
     string weightStr = "TOTAL EDGE WEIGHTS: " + to_string( numWeights );
@@ -554,18 +2813,130 @@ vector<string> ActorGraph::findSmallestTree() {
 
 }
 
-/* Destructor for the ActorGraph */
-ActorGraph::~ActorGraph() {
-    
-    auto actorIter = actorMap.begin();
-    auto movieIter = movieMap.begin();
-    while( actorIter != actorMap.end() ) {
-        delete actorIter->second;
-        actorIter++;
+
+/**
+ * This method makes the line printed for one edge of a movie tree.
+ * Parameter: edge - the edge to print
+ */
+string ActorGraph::formatEdge( const ForestEdge& edge ) const {
+    MovieNode* curEdge = movieList[edge.movie];
+    string outstr = pathStart( actorList[edge.actor1]->name );
+    outstr += "<--[";
+    outstr += curEdge->name;
+    outstr += "#@" + to_string(curEdge->year) + "]-->(";
+    outstr += actorList[edge.actor2]->name;
+    outstr += ')';
+    return outstr;
+}
+
+/**
+ * This method makes forest the smallest spanning forest of the graph as
+ * findSmallestTree finds it, with every credit of the graph seen, so it
+ * can be updated as credits are added.
+ * Parameter: forest - the forest to build, anything in it is replaced
+ */
+void ActorGraph::buildSpanningForest( SpanningForest& forest ) const {
+
+    forest = SpanningForest();
+    for( uint32_t i = 0; i < csr.numActors(); i++ ) { forest.addActor(); }
+    forest.castSeen = std::vector<uint32_t>( csr.numMovies() );
+    for( uint32_t i = 0; i < csr.numMovies(); i++ ) {
+        forest.castSeen[i] = csr.numActorsOf( i );
+    }
+    forest.touchedSeen = touchedMovies.size();
+    smallestTreeEdges( [this, &forest]( const ForestEdge& edge ) {
+        forest.addEdge( edge, ForestKey{ csr.movieWeights[edge.movie],
+                                         edge.movie, edge.place } );
+    } );
+
+}
+
+/**
+ * This method brings a smallest spanning forest up to date with the
+ * credits added to the graph since it was built or last updated. Each new
+ * edge of a movie's star goes into the forest if it joins two trees, or
+ * takes the place of the heaviest edge on the path between its actors if
+ * it is lighter than that edge, which the link cut tree finds in
+ * logarithmic time. Only the movies that loads added credits to since the
+ * forest last saw the graph are looked at, so the update does not depend on
+ * the size of the graph, though the load itself still rebuilds the
+ * adjacency arrays. The forest ends up the same as building it again, and
+ * only the edges that changed are returned, each list in the order
+ * Kruskal's algorithm takes edges.
+ * Parameter: forest - the forest to update
+ */
+ForestChanges ActorGraph::updateSpanningForest(
+    SpanningForest& forest ) const {
+
+    ForestChanges changes = ForestChanges();
+    //the tree nodes of the edges added by this update and if they still are
+    vector<uint32_t> addedNodes = std::vector<uint32_t>();
+    vector<bool> isAdded = std::vector<bool>();
+
+    while( forest.actorNodes.size() < csr.numActors() ) { forest.addActor(); }
+    if( forest.castSeen.size() < csr.numMovies() ) {
+        forest.castSeen.resize( csr.numMovies(), 0 );
+    }
+
+    //go through the credits of every touched movie that were not seen yet,
+    //a movie touched by several loads has nothing left to see after the
+    //first time
+    for( ; forest.touchedSeen < touchedMovies.size(); forest.touchedSeen++ ) {
+
+        uint32_t movie = touchedMovies[forest.touchedSeen];
+        uint32_t castSize = csr.numActorsOf( movie );
+        uint32_t place = forest.castSeen[movie] > 1 ?
+                         forest.castSeen[movie] : 1;
+        forest.castSeen[movie] = castSize;
+        const uint32_t* cast = csr.actorsBegin( movie );
+        for( ; place < castSize; place++ ) {
+
+            uint32_t node1 = forest.actorNodes[cast[0]];
+            uint32_t node2 = forest.actorNodes[cast[place]];
+            if( node1 == node2 ) { continue; }
+            ForestKey key = { csr.movieWeights[movie], movie, place };
+
+            //an edge that closes a loop replaces the heaviest edge on it
+            if( forest.tree.connected( node1, node2 ) ) {
+                uint32_t heaviest = forest.tree.pathLargest( node1, node2 );
+                if( !( key < forest.tree.key( heaviest ) ) ) { continue; }
+                if( heaviest < isAdded.size() && isAdded[heaviest] ) {
+                    isAdded[heaviest] = false;
+                } else {
+                    changes.removed.push_back( forest.nodeEdges[heaviest] );
+                }
+                forest.removeEdge( heaviest );
+            }
+
+            uint32_t node = forest.addEdge(
+                ForestEdge{ movie, place, cast[0], cast[place] }, key );
+            if( node >= isAdded.size() ) { isAdded.resize( node + 1 ); }
+            isAdded[node] = true;
+            addedNodes.push_back( node );
+
+        }
+
     }
-    while( movieIter != movieMap.end() ) {
-        delete movieIter->second;
-        movieIter++;
-    } 
+
+    //a node can be added, taken out and used again in one update
+    std::sort( addedNodes.begin(), addedNodes.end() );
+    addedNodes.erase( std::unique( addedNodes.begin(), addedNodes.end() ),
+                      addedNodes.end() );
+    for( size_t i = 0; i < addedNodes.size(); i++ ) {
+        if( isAdded[addedNodes[i]] ) {
+            changes.added.push_back( forest.nodeEdges[addedNodes[i]] );
+        }
+    }
+    auto kruskalOrder = [this]( const ForestEdge& e1, const ForestEdge& e2 ) {
+        return ForestKey{ csr.movieWeights[e1.movie], e1.movie, e1.place } <
+               ForestKey{ csr.movieWeights[e2.movie], e2.movie, e2.place };
+    };
+    std::sort( changes.added.begin(), changes.added.end(), kruskalOrder );
+    std::sort( changes.removed.begin(), changes.removed.end(),
+               kruskalOrder );
+    return changes;
 
 }
+
+/* Destructor for the ActorGraph, the arenas free every node */
+ActorGraph::~ActorGraph() {}
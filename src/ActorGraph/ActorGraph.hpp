@@ -12,14 +12,52 @@
 #ifndef ACTORGRAPH_HPP
 #define ACTORGRAPH_HPP
 
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 #include "ActorNode.hpp"
 #include "MovieNode.hpp"
+#include "ContractionHierarchy.hpp"
+#include "DistanceOracle.hpp"
+#include "FlatNameIndex.hpp"
+#include "GraphCSR.hpp"
+#include "Landmarks.hpp"
+#include "NodeArena.hpp"
+#include "StringPool.hpp"
+#include "QueryContext.hpp"
+#include "SpanningForest.hpp"
 #include "UnionFind.hpp"
 
 using namespace std;
 
+/* The searches that can answer a batch of path queries. SEARCH_MULTI_SOURCE
+ * is a breadth first search that runs the searches of 64 starting actors at
+ * once with a bit for each, SEARCH_ALT is an A* search guided by the
+ * landmarks of the graph, SEARCH_HIERARCHY searches the contraction
+ * hierarchy of the graph and SEARCH_WEIGHTED_BIDIRECTIONAL is Dijkstra's
+ * algorithm from both actors at once. */
+enum PathSearch {
+    SEARCH_BFS,
+    SEARCH_BIDIRECTIONAL,
+    SEARCH_DIJKSTRA,
+    SEARCH_DIAL,
+    SEARCH_MULTI_SOURCE,
+    SEARCH_ALT,
+    SEARCH_HIERARCHY,
+    SEARCH_WEIGHTED_BIDIRECTIONAL
+};
+
+/* One query of a batch that shares its starting actor with others, the
+ * actor it ends at and where its path goes in the results */
+struct PathTarget {
+    uint32_t actor;
+    size_t index;
+};
+
 /**
  * This class contains functions that have to do with the actors and movies in
  * the graph. The most important function is loadfromFile which takes in a 
@@ -30,9 +68,143 @@ using namespace std;
 class ActorGraph {
   protected:
     
-    //The hash maps that will hold the actors and the movies of the graph
-    unordered_map<string, ActorNode*> actorMap;
-    unordered_map<string, MovieNode*> movieMap;
+    //every actor name and movie title of the graph, stored once
+    StringPool namePool;
+    //The hash indexes from the names of the actors and the title and year
+    //of the movies of the graph to their dense ids
+    FlatNameIndex actorIndex;
+    FlatNameIndex movieIndex;
+    //the name of every actor by dense id, kept together so the actor index
+    //can check a name without going through the actor's node
+    vector<string_view> actorNames;
+
+    //the blocks every actor and movie node of the graph is created in
+    NodeArena<ActorNode> actorArena;
+    NodeArena<MovieNode> movieArena;
+    //every actor and movie by its dense id, in the order they were added
+    vector<ActorNode*> actorList;
+    vector<MovieNode*> movieList;
+    //the movies of every actor and the actors of every movie by dense id
+    GraphCSR csr;
+    //the ids of the movies every load added credits to, once per load and
+    //in load order, so a spanning forest only looks at those movies
+    vector<uint32_t> touchedMovies;
+    //the search state used by the methods that are not given a context
+    QueryContext defaultContext;
+    //the distance labels of every actor, empty until built or loaded
+    DistanceOracle oracle;
+    //the landmark distances of every actor, empty until built
+    Landmarks landmarks;
+    //the ranks and shortcuts of every actor and movie, empty until built
+    ContractionHierarchy hierarchy;
+
+    /* Builds the formatted path from the start of a search to actorEnd */
+    string formatPath( uint32_t actorEnd, const QueryContext& context ) const;
+
+    /* Marks every target in the context, returns how many actors there
+     * are among the targets */
+    size_t markTargets( const vector<PathTarget>& targets,
+                        QueryContext& context ) const;
+
+    /* Writes the path to curActor for every target that ends there */
+    void settleTarget( uint32_t curActor, const vector<PathTarget>& targets,
+                       vector<string>& results, QueryContext& context ) const;
+
+    /* Sorts a batch of queries into the searches that answer them */
+    void groupQueries( const vector<pair<string, string>>& queries,
+                       PathSearch& search,
+                       vector<pair<uint32_t, PathTarget>>& sorted,
+                       vector<size_t>& groups ) const;
+
+    /* Runs the search of the group of queries from begin to end in sorted */
+    void runGroup( const vector<pair<string, string>>& queries,
+                   PathSearch search,
+                   const vector<pair<uint32_t, PathTarget>>& sorted,
+                   size_t begin, size_t end, vector<PathTarget>& targets,
+                   vector<string>& results, QueryContext& context ) const;
+
+    /* The breadth first search, heap Dijkstra and bucket queue Dijkstra
+     * from startActor until all of the targets are reached */
+    void closestFrom( uint32_t startActor, const vector<PathTarget>& targets,
+                      vector<string>& results, QueryContext& context ) const;
+    void weightedFrom( uint32_t startActor, const vector<PathTarget>& targets,
+                       vector<string>& results, QueryContext& context ) const;
+    void weightedFromDial( uint32_t startActor,
+                           const vector<PathTarget>& targets,
+                           vector<string>& results,
+                           QueryContext& context ) const;
+
+    /* The A* search from startActor to endActor guided by the landmarks,
+     * returns the formatted path or an empty string if there is none */
+    string weightedPathALT( uint32_t startActor, uint32_t endActor,
+                            QueryContext& context ) const;
+
+    /* The contraction hierarchy search from startActor to endActor,
+     * returns the formatted path or an empty string if there is none */
+    string weightedPathCH( uint32_t startActor, uint32_t endActor,
+                           QueryContext& context ) const;
+
+    /* Answers the queries of up to 64 starting actors from begin to end in
+     * sorted with one multi source breadth first search */
+    void multiSourceFrom( const vector<pair<uint32_t, PathTarget>>& sorted,
+                          size_t begin, size_t end, vector<string>& results,
+                          QueryContext& context ) const;
+
+    /* Builds the formatted path of one search of a multi source search */
+    string formatMultiSourcePath( uint32_t actorEnd, uint64_t bit,
+                                  unsigned int level,
+                                  const QueryContext& context ) const;
+
+    /* Builds the formatted path from actorMeet to the end of a
+     * bidirectional search, without actorMeet itself */
+    string formatBackPath( uint32_t actorMeet,
+                           const QueryContext& context ) const;
+
+    /* Expands every actor of one side's frontier of a bidirectional search
+     * by one level, returns the first actor both sides have seen or NO_ID */
+    uint32_t expandFrontier( const vector<uint32_t>& frontier,
+                             vector<uint32_t>& nextFrontier, bool fromStart,
+                             QueryContext& context ) const;
+
+    /* Kruskal's algorithm for findSmallestTree, hands every edge of the
+     * forest to visit in the order they were chosen */
+    void smallestTreeEdges(
+        const function<void(const ForestEdge&)>& visit ) const;
+
+    /* Boruvka's algorithm for findSmallestTreeBoruvka on numThreads
+     * threads, hands every edge of the forest to visit in the same order
+     * as smallestTreeEdges */
+    void boruvkaTreeEdges( unsigned int numThreads,
+        const function<void(const ForestEdge&)>& visit ) const;
+
+    /* Makes the lines printed for a forest of movie trees from every edge
+     * in the forest */
+    vector<string> formatTree( const vector<ForestEdge>& treeEdges ) const;
+
+    /* Makes the lines printed after the edges of a forest of movie trees */
+    vector<string> treeTotals( size_t numEdges,
+                               unsigned int numWeights ) const;
+
+    /* Finds the actor with the given name, returns 0 if there is none */
+    ActorNode* findActor( string_view name ) const;
+
+    /* Finds the actor with the given name or adds it to the graph */
+    ActorNode* findOrAddActor( string_view name );
+
+    /* Finds the movie with the given title and year or adds it to the
+     * graph */
+    MovieNode* findOrAddMovie( string_view title, int year );
+
+    /* Parses the lines between begin and fileEnd on this thread and adds
+     * their credits to credits in file order */
+    void loadLines( const char* begin, const char* fileEnd,
+                    vector<pair<uint32_t, uint32_t>>& credits );
+
+    /* Parses the lines between begin and fileEnd on numThreads threads and
+     * adds their credits to credits in file order */
+    void loadChunks( const char* begin, const char* fileEnd,
+                     unsigned int numThreads,
+                     vector<pair<uint32_t, uint32_t>>& credits );
 
   public:
     /**
@@ -48,11 +220,77 @@ class ActorGraph {
      * list of an actor, a movie they played in, and the year of the movie and
      * builds either a weighted or unweighted graph based on the info. The
      * weight of the movie is how old the movie is which is 2020-year.
+     * The file is memory mapped and each line is split in place, so only
+     * the names of new actors and movies are ever copied out of it. Large
+     * files are split at line boundaries and parsed by several threads, then
+     * merged in file order so the graph is the same as a single thread load.
      * Parameter: in_filename - the name of the file containing the info
-     * Parameter: use_weighted_edges - whether the graph is weighted or not
+     * Parameter: numThreads - the most threads to parse with, 0 for all cores
      */
-    bool loadFromFile(const char* in_filename);
+    bool loadFromFile(const char* in_filename, unsigned int numThreads = 1);
+
+    /**
+     * This function writes the graph to a binary snapshot. The snapshot
+     * holds every name once, dense ids for the actors and movies and both
+     * adjacency lists as flat arrays of ids.
+     * Parameter: out_filename - the name of the snapshot file to write
+     */
+    bool saveSnapshot(const char* out_filename) const;
+
+    /**
+     * This function loads a graph that was saved with saveSnapshot. The
+     * snapshot is memory mapped and the graph is built straight from its
+     * arrays, so no text is parsed and no hash maps are filled. The graph
+     * must be empty. Files can be loaded into it afterwards, the first one
+     * builds the movie index the snapshot does not keep.
+     * Parameter: in_filename - the name of the snapshot file to load
+     */
+    bool loadSnapshot(const char* in_filename);
+
+    /**
+     * This function loads a snapshot if the file is one and otherwise
+     * loads the file as a credit database with loadFromFile.
+     * Parameter: in_filename - the name of the database or snapshot file
+     * Parameter: numThreads - the most threads to parse a database with
+     */
+    bool load(const char* in_filename, unsigned int numThreads = 1);
     
+    /**
+     * This method answers a whole batch of path queries with the given
+     * search. Queries that start at the same actor are answered by a single
+     * search that runs until all of their end actors are reached. The
+     * results are in the order of the queries and are the same strings the
+     * single query methods return. Large batches of SEARCH_BFS queries run
+     * 64 searches at once with SEARCH_MULTI_SOURCE, which returns shortest
+     * paths too but may pick a different one when there are ties.
+     * Parameter: queries - the starting and ending actor of every query
+     * Parameter: search - the search that answers the queries
+     */
+    vector<string> findPaths(const vector<pair<string, string>>& queries,
+                             PathSearch search);
+
+    /**
+     * This method is findPaths with all of the search state kept in the
+     * given context.
+     * Parameter: queries - the starting and ending actor of every query
+     * Parameter: search - the search that answers the queries
+     * Parameter: context - the search state, one per thread searching
+     */
+    vector<string> findPaths(const vector<pair<string, string>>& queries,
+                             PathSearch search, QueryContext& context) const;
+
+    /**
+     * This method is findPaths with the searches spread over several
+     * threads, each with its own context. The graph is only read, and the
+     * results are the same and in the same order as with one thread.
+     * Parameter: queries - the starting and ending actor of every query
+     * Parameter: search - the search that answers the queries
+     * Parameter: numThreads - the number of threads, 0 for all cores
+     */
+    vector<string> findPaths(const vector<pair<string, string>>& queries,
+                             PathSearch search,
+                             unsigned int numThreads) const;
+
     /**
      * This method uses a breadth first search in order to find the 
      * shortest path between two actors. The return value is a formatted
@@ -63,6 +301,99 @@ class ActorGraph {
      */
     string findClosestActors(string actorStart, string actorEnd);
 
+    /**
+     * This method is findClosestActors with all of the search state kept
+     * in the given context, so any number of threads can search the graph
+     * at the same time as long as each one has its own context.
+     * Parameter: actorStart - the actor that will be the start of the search
+     * Parameter: actorEnd - the actor that will be found in the search
+     * Parameter: context - the search state, one per thread searching
+     */
+    string findClosestActors(const string& actorStart, const string& actorEnd,
+                             QueryContext& context) const;
+
+    /**
+     * This method finds the same kind of shortest path as findClosestActors
+     * with a bidirectional breadth first search, growing whichever of the
+     * two frontiers is smaller until they meet. When there are several
+     * shortest paths it may return a different one than findClosestActors.
+     * Parameter: actorStart - the actor that will be the start of the search
+     * Parameter: actorEnd - the actor that will be found in the search
+     */
+    string findClosestActorsBidirectional(string actorStart, string actorEnd);
+
+    /**
+     * This method is findClosestActorsBidirectional with all of the search
+     * state kept in the given context.
+     * Parameter: actorStart - the actor that will be the start of the search
+     * Parameter: actorEnd - the actor that will be found in the search
+     * Parameter: context - the search state, one per thread searching
+     */
+    string findClosestActorsBidirectional(const string& actorStart,
+                                          const string& actorEnd,
+                                          QueryContext& context) const;
+
+    /**
+     * This method finds the number of movies between the given actor and
+     * every other actor with a direction optimizing breadth first search.
+     * The distances are in the order the actors were added to the graph and
+     * actors that cannot be reached are (unsigned)-1.
+     * Parameter: actor - the actor every distance is measured from
+     */
+    vector<unsigned int> findActorDistances(string actor);
+
+    /**
+     * This method is findActorDistances with all of the search state kept
+     * in the given context.
+     * Parameter: actor - the actor every distance is measured from
+     * Parameter: context - the search state, one per thread searching
+     */
+    vector<unsigned int> findActorDistances(const string& actor,
+                                            QueryContext& context) const;
+
+    /**
+     * This method builds a distance oracle for the graph, which labels
+     * every actor with a few hub actors and its distance to them so that
+     * findActorDistance and findOraclePath never have to search. Building
+     * it takes one pruned search per actor.
+     */
+    void buildDistanceOracle();
+
+    /**
+     * This method writes the distance oracle to a file that can be loaded
+     * next to the same graph instead of building the oracle again.
+     * Parameter: out_filename - the name of the oracle file to write
+     */
+    bool saveDistanceOracle(const char* out_filename) const;
+
+    /**
+     * This method loads a distance oracle written by saveDistanceOracle.
+     * Returns false if the file is not an oracle of this graph.
+     * Parameter: in_filename - the name of the oracle file to load
+     */
+    bool loadDistanceOracle(const char* in_filename);
+
+    /**
+     * This method returns the number of movies on a shortest path between
+     * two actors using the distance oracle, or (unsigned)-1 if they are
+     * not connected. The oracle has to be built or loaded first.
+     * Parameter: actorStart - the actor the distance is measured from
+     * Parameter: actorEnd - the actor the distance is measured to
+     */
+    unsigned int findActorDistance(const string& actorStart,
+                                   const string& actorEnd) const;
+
+    /**
+     * This method returns a shortest path between two actors formatted like
+     * findClosestActors, found by following the distance oracle one movie
+     * at a time. When there are several shortest paths it may return a
+     * different one than findClosestActors.
+     * Parameter: actorStart - the actor that will be the start of the path
+     * Parameter: actorEnd - the actor that will be the end of the path
+     */
+    string findOraclePath(const string& actorStart,
+                          const string& actorEnd) const;
+
     /**
      * This method uses Dijkstra's Algoritm to find the closest actor
      * and movie chain from actorStart to actorEnd. The difference between
@@ -73,25 +404,214 @@ class ActorGraph {
      * Parameter: actorEnd - the ending actor in the actor/movie chain
      */
     string findWeightedActors(string actorStart, string actorEnd);
+
+    /**
+     * This method is findWeightedActors with all of the search state kept
+     * in the given context.
+     * Parameter: actorStart - the starting actor in the actor/movie chain
+     * Parameter: actorEnd - the ending actor in the actor/movie chain
+     * Parameter: context - the search state, one per thread searching
+     */
+    string findWeightedActors(const string& actorStart,
+                              const string& actorEnd,
+                              QueryContext& context) const;
     
+    /**
+     * This method finds the same kind of path as findWeightedActors with
+     * Dial's algorithm, keeping the actors in one bucket per distance
+     * instead of a binary heap. When there are several lightest paths it
+     * may return a different one than findWeightedActors.
+     * Parameter: actorStart - the starting actor in the actor/movie chain
+     * Parameter: actorEnd - the ending actor in the actor/movie chain
+     */
+    string findWeightedActorsDial(string actorStart, string actorEnd);
+
+    /**
+     * This method is findWeightedActorsDial with all of the search state
+     * kept in the given context.
+     * Parameter: actorStart - the starting actor in the actor/movie chain
+     * Parameter: actorEnd - the ending actor in the actor/movie chain
+     * Parameter: context - the search state, one per thread searching
+     */
+    string findWeightedActorsDial(const string& actorStart,
+                                  const string& actorEnd,
+                                  QueryContext& context) const;
+
+    /**
+     * This method finds the same kind of path as findWeightedActors with
+     * Dijkstra's algorithm from both actors at once, stopping as soon as
+     * the next actors of the two sides are together at least as far apart
+     * as the lightest path between them found so far. When there are
+     * several lightest paths it may return a different one than
+     * findWeightedActors.
+     * Parameter: actorStart - the starting actor in the actor/movie chain
+     * Parameter: actorEnd - the ending actor in the actor/movie chain
+     */
+    string findWeightedActorsBidirectional(string actorStart,
+                                           string actorEnd);
+
+    /**
+     * This method is findWeightedActorsBidirectional with all of the
+     * search state kept in the given context.
+     * Parameter: actorStart - the starting actor in the actor/movie chain
+     * Parameter: actorEnd - the ending actor in the actor/movie chain
+     * Parameter: context - the search state, one per thread searching
+     */
+    string findWeightedActorsBidirectional(const string& actorStart,
+                                           const string& actorEnd,
+                                           QueryContext& context) const;
+
+    /**
+     * This method picks landmark actors spread out over the graph and finds
+     * the weighted distance from each of them to every actor, which is what
+     * findWeightedActorsALT needs to guide its search. Each landmark takes
+     * one Dijkstra's search and keeps one distance per actor.
+     * Parameter: numLandmarks - the number of landmarks to pick
+     */
+    void buildLandmarks(unsigned int numLandmarks = 8);
+
+    /**
+     * This method finds the same kind of path as findWeightedActors with an
+     * A* search that uses the landmarks as a lower bound on the distance
+     * left to actorEnd, so it finishes far fewer actors. The path is always
+     * one of the lightest, but when there are several it may be a
+     * different one than findWeightedActors returns. Without landmarks the
+     * search is a plain Dijkstra's search.
+     * Parameter: actorStart - the starting actor in the actor/movie chain
+     * Parameter: actorEnd - the ending actor in the actor/movie chain
+     */
+    string findWeightedActorsALT(string actorStart, string actorEnd);
+
+    /**
+     * This method is findWeightedActorsALT with all of the search state
+     * kept in the given context.
+     * Parameter: actorStart - the starting actor in the actor/movie chain
+     * Parameter: actorEnd - the ending actor in the actor/movie chain
+     * Parameter: context - the search state, one per thread searching
+     */
+    string findWeightedActorsALT(const string& actorStart,
+                                 const string& actorEnd,
+                                 QueryContext& context) const;
+
+    /**
+     * This method builds a contraction hierarchy of the graph for
+     * findWeightedActorsCH. Every actor and movie is ranked and removed in
+     * that order, and shortcuts are added wherever removing one would make
+     * the lightest path between two of its neighbors longer. The nodes
+     * that would need too many shortcuts are left as a core that searches
+     * go through without any. The build is slow, but every search
+     * afterwards only goes up in rank until it reaches the core.
+     */
+    void buildHierarchy();
+
+    /**
+     * This method finds the same kind of path as findWeightedActors by
+     * searching the contraction hierarchy from both actors, going only up
+     * in rank, and unpacking the shortcuts of the lightest path it finds.
+     * When there are several lightest paths it may return a different one
+     * than findWeightedActors. Without a hierarchy it uses the bucket queue
+     * search of findWeightedActorsDial.
+     * Parameter: actorStart - the starting actor in the actor/movie chain
+     * Parameter: actorEnd - the ending actor in the actor/movie chain
+     */
+    string findWeightedActorsCH(string actorStart, string actorEnd);
+
+    /**
+     * This method is findWeightedActorsCH with all of the search state
+     * kept in the given context.
+     * Parameter: actorStart - the starting actor in the actor/movie chain
+     * Parameter: actorEnd - the ending actor in the actor/movie chain
+     * Parameter: context - the search state, one per thread searching
+     */
+    string findWeightedActorsCH(const string& actorStart,
+                                const string& actorEnd,
+                                QueryContext& context) const;
+
     /**
      * This method predicts what future links the given actor might have with
      * all of the other actors in the graph. The method seaches all of the
      * actors that have worked on the same movies as the input actor and makes
      * a sorted list of actors that have direclty collaborated and have not.
      * These two lists, directly collaborated and haven't collaborated, are
-     * returned in a pair.
+     * returned in a pair, each cut down to the numLinks best actors.
+     * Parameter: actor - the actor which we want to find all of the links of
+     * Parameter: numLinks - the most actors to return in each list
+     */
+    pair<vector<string>, vector<string>> getPredictedLinks(
+        string actor, unsigned int numLinks = 4 );
+
+    /**
+     * This method is getPredictedLinks with all of the search state kept
+     * in the given context.
      * Parameter: actor - the actor which we want to find all of the links of
+     * Parameter: context - the search state, one per thread searching
+     * Parameter: numLinks - the most actors to return in each list
      */
-    pair<vector<string>, vector<string>> getPredictedLinks( string actor );
+    pair<vector<string>, vector<string>> getPredictedLinks(
+        const string& actor, QueryContext& context,
+        unsigned int numLinks = 4 ) const;
 
     /**
      * This function uses Kruskal's algorithm along with the UnionFind
-     * datastructure in order to create the smallest spanning tree given
-     * a connected graph. This program will output a vector of the
-     * strings expected to be printed out.
+     * datastructure in order to create the smallest spanning tree of every
+     * connected group of actors, going through the movies once in order of
+     * weight. This program will output a vector of the strings expected to
+     * be printed out, with the number of trees when there is more than one.
+     */
+    vector<string> findSmallestTree() const;
+
+    /**
+     * This function writes the same lines as findSmallestTree to out, each
+     * edge as soon as it is chosen, so the lines are never all kept in
+     * memory. out is not flushed.
+     * Parameter: out - the stream the lines are written to
+     */
+    void writeSmallestTree( ostream& out ) const;
+
+    /**
+     * This function finds the same smallest spanning trees as
+     * findSmallestTree with Boruvka's algorithm, where the best edge out of
+     * every tree is found by several threads at once. The output is the
+     * same as findSmallestTree's.
+     * Parameter: numThreads - the number of threads, 0 for all cores
+     */
+    vector<string> findSmallestTreeBoruvka( unsigned int numThreads ) const;
+
+    /**
+     * This function writes the same lines as findSmallestTreeBoruvka to
+     * out without keeping them in memory. out is not flushed.
+     * Parameter: out - the stream the lines are written to
+     * Parameter: numThreads - the number of threads, 0 for all cores
+     */
+    void writeSmallestTreeBoruvka( ostream& out,
+                                   unsigned int numThreads ) const;
+
+    /**
+     * This function makes forest the same smallest spanning forest that
+     * findSmallestTree finds, in a form that updateSpanningForest can keep
+     * up to date as credits are added to the graph.
+     * Parameter: forest - the forest to build, anything in it is replaced
+     */
+    void buildSpanningForest( SpanningForest& forest ) const;
+
+    /**
+     * This function adds every credit loaded since forest was built or last
+     * updated to it. Each new edge joins two trees or replaces the heaviest
+     * edge on the loop it makes. Only the movies the loads since gave
+     * credits to are looked at, so the work only depends on the number of
+     * new credits, but loadFromFile still rebuilds the adjacency arrays of
+     * the whole graph. Only the edges that went into or out of the forest
+     * are returned, and the forest ends up the same as building it again.
+     * Parameter: forest - the forest to update
+     */
+    ForestChanges updateSpanningForest( SpanningForest& forest ) const;
+
+    /**
+     * This function makes the line printed for one edge of a movie tree,
+     * the same way findSmallestTree prints it.
+     * Parameter: edge - the edge to print
      */
-    vector<string> findSmallestTree();
+    string formatEdge( const ForestEdge& edge ) const;
     
 };
 
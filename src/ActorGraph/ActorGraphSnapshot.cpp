@@ -0,0 +1,356 @@
+/* This file contains the methods of the ActorGraph class that save a graph
+ * to a binary snapshot and load it back. A snapshot stores every name once
+ * in a single block of text, refers to actors and movies by their dense ids
+ * and keeps both adjacency lists as flat arrays, so loading one is a matter
+ * of mapping the file and copying arrays instead of parsing and hashing the
+ * whole database again.
+ * Author: Christian Kouris
+ * Email: ckouris@ucsd.edu
+ * Sources: cplusplus documentation for: ofstream, ifstream, memcpy
+ */
+
+#include "ActorGraph.hpp"
+#include "MappedFile.hpp"
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+//identifies a snapshot file and the layout version it was written with
+static const char SNAPSHOT_MAGIC[8] = { 'A', 'G', 'S', 'N', 'A', 'P', '\0',
+                                        '\0' };
+static const uint32_t SNAPSHOT_VERSION = 2;
+//the first version, which stored the actor ids sorted by name instead of
+//the actor index and can still be loaded
+static const uint32_t SNAPSHOT_VERSION_SORTED = 1;
+
+/* The fixed size header at the start of every snapshot. The sections that
+ * follow it are, in order: actor name offsets (numActors + 1), movie name
+ * offsets (numMovies + 1), movie years (numMovies), actor adjacency offsets
+ * (numActors + 1), the movie id of every credit grouped by actor
+ * (numCredits), movie adjacency offsets (numMovies + 1), the actor id of
+ * every credit grouped by movie (numCredits), the number of slots of the
+ * actor index (1), the hash and id of every slot of the actor index (2 per
+ * slot) and finally the name text itself (nameBytes). Every section except
+ * the text is an array of 32 bit values in the machine's byte order.
+ * Version 1 snapshots have the actor ids sorted by name (numActors) in
+ * place of the two actor index sections.
+ */
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t numActors;
+    uint32_t numMovies;
+    uint32_t numCredits;
+    uint64_t nameBytes;
+};
+
+/* Writes an array of 32 bit values to the snapshot
+ * Parameter: out - the snapshot being written
+ * Parameter: values - the values to write
+ */
+static void writeArray( ofstream& out, const vector<uint32_t>& values ) {
+    out.write( (const char*)values.data(),
+               values.size() * sizeof(uint32_t) );
+}
+
+/* Reads consecutive sections out of a mapped snapshot and makes sure that
+ * no section runs past the end of the file.
+ */
+class SnapshotReader {
+
+  private:
+
+    const char* cur;
+    const char* end;
+
+  public:
+
+    SnapshotReader( const char* begin, const char* end )
+        : cur(begin), end(end) {}
+
+    /* Returns the next count 32 bit values, or 0 if the file is too short
+     * Parameter: count - the number of values in the section
+     */
+    const uint32_t* array( size_t count ) {
+        if( (size_t)(end - cur) / sizeof(uint32_t) < count ) { return 0; }
+        const uint32_t* section = (const uint32_t*)cur;
+        cur += count * sizeof(uint32_t);
+        return section;
+    }
+
+    /* Returns the next count bytes, or 0 if the file is too short
+     * Parameter: count - the number of bytes in the section
+     */
+    const char* bytes( size_t count ) {
+        if( (size_t)(end - cur) < count ) { return 0; }
+        const char* section = cur;
+        cur += count;
+        return section;
+    }
+
+};
+
+/* Checks that an offsets section starts at first, never decreases and ends
+ * at last, so every range it describes is inside its section.
+ * Parameter: offsets - the offsets to check
+ * Parameter: count - the number of ranges, the array holds count + 1 values
+ * Parameter: first - the value the first offset must have
+ * Parameter: last - the value the last offset must have
+ */
+static bool validOffsets( const uint32_t* offsets, uint32_t count,
+                          uint64_t first, uint64_t last ) {
+    if( offsets == 0 || offsets[0] != first || offsets[count] != last ) {
+        return false;
+    }
+    for( uint32_t i = 0; i < count; i++ ) {
+        if( offsets[i] > offsets[i + 1] ) { return false; }
+    }
+    return true;
+}
+
+/* Checks that every id in an adjacency section is a valid id
+ * Parameter: ids - the ids to check
+ * Parameter: count - the number of ids
+ * Parameter: limit - the number of nodes the ids refer to
+ */
+static bool validIds( const uint32_t* ids, uint32_t count, uint32_t limit ) {
+    if( ids == 0 ) { return false; }
+    for( uint32_t i = 0; i < count; i++ ) {
+        if( ids[i] >= limit ) { return false; }
+    }
+    return true;
+}
+
+/* Checks that an actor index section holds every actor once at most and
+ * leaves at least half of its slots empty, so every lookup in it ends at an
+ * empty slot and only ever returns a valid id
+ * Parameter: slots - the slots of the index
+ * Parameter: numSlots - the number of slots, a power of two
+ * Parameter: numActors - the number of actors the index holds
+ */
+static bool validIndex( const FlatNameIndex::Slot* slots, uint32_t numSlots,
+                        uint32_t numActors ) {
+    if( slots == 0 || (numSlots & (numSlots - 1)) != 0 ||
+        (uint64_t)numActors * 2 > numSlots ) {
+        return false;
+    }
+    vector<char> seen = std::vector<char>( numActors, false );
+    uint32_t count = 0;
+    for( uint32_t i = 0; i < numSlots; i++ ) {
+        uint32_t id = slots[i].id;
+        if( id == FlatNameIndex::NOT_FOUND ) { continue; }
+        if( id >= numActors || seen[id] ) { return false; }
+        seen[id] = true;
+        count++;
+    }
+    return count == numActors;
+}
+
+/**
+ * This function writes the graph to a binary snapshot that can be loaded
+ * with loadSnapshot. Returns false if the file could not be written.
+ * Parameter: out_filename - the name of the snapshot file to write
+ */
+bool ActorGraph::saveSnapshot( const char* out_filename ) const {
+
+    SnapshotHeader header;
+    memcpy( header.magic, SNAPSHOT_MAGIC, sizeof(header.magic) );
+    header.version = SNAPSHOT_VERSION;
+    header.numActors = actorList.size();
+    header.numMovies = movieList.size();
+    header.numCredits = csr.numCredits();
+    header.nameBytes = 0;
+
+    //offsets of every name in the text section
+    vector<uint32_t> actorNames = std::vector<uint32_t>( 1, 0 );
+    vector<uint32_t> movieNames = std::vector<uint32_t>();
+    vector<uint32_t> movieYears = std::vector<uint32_t>();
+    for( unsigned int i = 0; i < actorList.size(); i++ ) {
+        header.nameBytes += actorList[i]->name.size();
+        actorNames.push_back( header.nameBytes );
+    }
+    movieNames.push_back( header.nameBytes );
+    for( unsigned int i = 0; i < movieList.size(); i++ ) {
+        header.nameBytes += movieList[i]->name.size();
+        movieNames.push_back( header.nameBytes );
+        movieYears.push_back( movieList[i]->year );
+    }
+
+    //every offset in the file is 32 bits wide
+    if( header.nameBytes > UINT32_MAX ) {
+        cerr << "Graph is too large for a snapshot!\n";
+        return false;
+    }
+    //a loaded snapshot uses the actor index as it was saved
+    uint32_t numSlots = actorIndex.slots.size();
+
+    ofstream out( out_filename, ios::binary );
+    if( !out ) {
+        cerr << "Failed to write " << out_filename << "!\n";
+        return false;
+    }
+    out.write( (const char*)&header, sizeof(header) );
+    writeArray( out, actorNames );
+    writeArray( out, movieNames );
+    writeArray( out, movieYears );
+    //the adjacency arrays are written exactly as they are in memory
+    writeArray( out, csr.actorOffsets );
+    writeArray( out, csr.actorMovies );
+    writeArray( out, csr.movieOffsets );
+    writeArray( out, csr.movieActors );
+    out.write( (const char*)&numSlots, sizeof(numSlots) );
+    out.write( (const char*)actorIndex.slots.data(),
+               numSlots * sizeof(FlatNameIndex::Slot) );
+    for( unsigned int i = 0; i < actorList.size(); i++ ) {
+        out << actorList[i]->name;
+    }
+    for( unsigned int i = 0; i < movieList.size(); i++ ) {
+        out << movieList[i]->name;
+    }
+    out.close();
+
+    if( !out ) {
+        cerr << "Failed to write " << out_filename << "!\n";
+        return false;
+    }
+    return true;
+
+}
+
+/**
+ * This function loads a graph from a binary snapshot written by
+ * saveSnapshot. The snapshot is mapped into memory and its flat arrays are
+ * copied straight into the graph's GraphCSR, so no text is parsed and no
+ * names are hashed. Actors are looked up with the actor index stored in the
+ * snapshot, only a version 1 snapshot has to build it again. The movie
+ * index is not stored, loadFromFile builds it again from the movies the
+ * first time a file is added to the graph.
+ * The graph must be empty. Returns false if the file is not a valid
+ * snapshot.
+ * Parameter: in_filename - the name of the snapshot file to load
+ */
+bool ActorGraph::loadSnapshot( const char* in_filename ) {
+
+    if( !actorList.empty() || !movieList.empty() ) {
+        cerr << "A snapshot can only be loaded into an empty graph!\n";
+        return false;
+    }
+
+    MappedFile infile( in_filename );
+    SnapshotReader reader( infile.data(), infile.data() + infile.size() );
+    const SnapshotHeader* header =
+        (const SnapshotHeader*)reader.bytes( sizeof(SnapshotHeader) );
+    if( !infile.isOpen() || header == 0 ||
+        memcmp( header->magic, SNAPSHOT_MAGIC, sizeof(header->magic) ) != 0 ||
+        (header->version != SNAPSHOT_VERSION &&
+         header->version != SNAPSHOT_VERSION_SORTED) ) {
+        cerr << "Failed to read " << in_filename << "!\n";
+        return false;
+    }
+
+    uint32_t numActors = header->numActors;
+    uint32_t numMovies = header->numMovies;
+    uint32_t numCredits = header->numCredits;
+    const uint32_t* actorNameEnds = reader.array( (size_t)numActors + 1 );
+    const uint32_t* movieNameEnds = reader.array( (size_t)numMovies + 1 );
+    const uint32_t* movieYears = reader.array( numMovies );
+    const uint32_t* actorOffsets = reader.array( (size_t)numActors + 1 );
+    const uint32_t* actorMovies = reader.array( numCredits );
+    const uint32_t* movieOffsets = reader.array( (size_t)numMovies + 1 );
+    const uint32_t* movieActors = reader.array( numCredits );
+    //the index of a version 1 snapshot is built again from the names
+    bool hasIndex = header->version == SNAPSHOT_VERSION;
+    const uint32_t* numSlots = hasIndex ? reader.array( 1 ) : 0;
+    const FlatNameIndex::Slot* slots = 0;
+    if( numSlots != 0 ) {
+        slots = (const FlatNameIndex::Slot*)reader.array(
+            (size_t)*numSlots * 2 );
+    }
+    const uint32_t* byName = hasIndex ? 0 : reader.array( numActors );
+    const char* names = reader.bytes( header->nameBytes );
+
+    //make sure a damaged file can never index outside of the mapping
+    if( names == 0 || movieNameEnds == 0 || movieYears == 0 ||
+        !validOffsets( actorNameEnds, numActors, 0, movieNameEnds[0] ) ||
+        !validOffsets( movieNameEnds, numMovies, movieNameEnds[0],
+                       header->nameBytes ) ||
+        !validOffsets( actorOffsets, numActors, 0, numCredits ) ||
+        !validOffsets( movieOffsets, numMovies, 0, numCredits ) ||
+        !validIds( actorMovies, numCredits, numMovies ) ||
+        !validIds( movieActors, numCredits, numActors ) ||
+        ( hasIndex && ( numSlots == 0 ||
+                        !validIndex( slots, *numSlots, numActors ) ) ) ||
+        ( !hasIndex && !validIds( byName, numActors, numActors ) ) ) {
+        cerr << "Failed to read " << in_filename << "!\n";
+        return false;
+    }
+
+    //create every node by its id, with all of the names in one block
+    namePool.reserve( header->nameBytes );
+    actorList.reserve( numActors );
+    actorArena.reserve( numActors );
+    actorNames.reserve( numActors );
+    for( uint32_t i = 0; i < numActors; i++ ) {
+        string_view name = namePool.add( string_view( names +
+            actorNameEnds[i], actorNameEnds[i + 1] - actorNameEnds[i] ) );
+        actorList.push_back( actorArena.create( name, i ) );
+        actorNames.push_back( name );
+    }
+    movieList.reserve( numMovies );
+    movieArena.reserve( numMovies );
+    for( uint32_t i = 0; i < numMovies; i++ ) {
+        string_view name = namePool.add( string_view( names +
+            movieNameEnds[i], movieNameEnds[i + 1] - movieNameEnds[i] ) );
+        movieList.push_back( movieArena.create( name, movieYears[i], i ) );
+    }
+
+    //the adjacency is used exactly as it was saved
+    csr.actorOffsets.assign( actorOffsets, actorOffsets + numActors + 1 );
+    csr.actorMovies.assign( actorMovies, actorMovies + numCredits );
+    csr.movieOffsets.assign( movieOffsets, movieOffsets + numMovies + 1 );
+    csr.movieActors.assign( movieActors, movieActors + numCredits );
+    vector<uint32_t> weights = std::vector<uint32_t>( numMovies );
+    for( uint32_t i = 0; i < numMovies; i++ ) {
+        weights[i] = movieList[i]->weight;
+    }
+    csr.setWeights( weights );
+    if( hasIndex ) {
+        actorIndex.slots.assign( slots, slots + *numSlots );
+        actorIndex.count = numActors;
+    } else {
+        actorIndex.reserve( numActors );
+        for( uint32_t i = 0; i < numActors; i++ ) {
+            actorIndex.insert( FlatNameIndex::hash( actorNames[i] ),
+                               i );
+        }
+    }
+
+    return true;
+
+}
+
+/**
+ * This function loads the graph from either a credit database or a binary
+ * snapshot, depending on what the file starts with.
+ * Parameter: in_filename - the name of the database or snapshot file
+ * Parameter: numThreads - the most threads to parse a database with
+ */
+bool ActorGraph::load( const char* in_filename, unsigned int numThreads ) {
+
+    char magic[sizeof(SNAPSHOT_MAGIC)];
+    ifstream infile( in_filename, ios::binary );
+    bool isSnapshot = infile.read( magic, sizeof(magic) ) &&
+        memcmp( magic, SNAPSHOT_MAGIC, sizeof(magic) ) == 0;
+    infile.close();
+
+    if( isSnapshot ) { return loadSnapshot( in_filename ); }
+    return loadFromFile( in_filename, numThreads );
+
+}
@@ -0,0 +1,354 @@
+/* This file contains the methods of the ContractionHierarchy class, which
+ * ranks the actors and movies of a graph, adds the shortcuts that removing
+ * them in that order needs and turns shortcuts back into paths.
+ * Author: Christian Kouris
+ * Email: ckouris@ucsd.edu
+ * Sources: Geisberger, Sanders, Schultes and Delling, Contraction
+ *          Hierarchies: Faster and Simpler Hierarchical Routing in Road
+ *          Networks; cplusplus documentation for: priority_queue
+ */
+
+#include "ContractionHierarchy.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+//marks an edge of the graph that is not a shortcut
+static const uint32_t NO_MIDDLE = (uint32_t)-1;
+//nodes are only removed while they add at most this many more shortcuts
+//than the edges they take away
+static const int CORE_EDGE_DIFFERENCE = 4;
+//a witness search gives up and lets the shortcut be added after finishing
+//this many nodes, which only ever adds shortcuts that are not needed
+static const uint32_t WITNESS_SETTLE_LIMIT = 40;
+
+/* An edge of the graph while it is being contracted */
+struct HierarchyEdge {
+    uint32_t node;
+    uint32_t weight;
+    uint32_t middle;
+};
+
+/* A shortcut that removing a node needs */
+struct Shortcut {
+    uint32_t node1;
+    uint32_t node2;
+    uint32_t weight;
+};
+
+/* Holds the graph while its nodes are removed one at a time, along with the
+ * state of the witness searches that decide which shortcuts are needed.
+ */
+class HierarchyBuilder {
+
+  public:
+
+    //the edges of every node to the nodes that are not removed yet, and
+    //to some that are, which are skipped
+    vector<vector<HierarchyEdge>> edges;
+    //whether each node is removed and how many of its neighbors are
+    vector<char> removed;
+    vector<int> removedNeighbors;
+
+    /* Constructor that copies the bipartite graph
+     * Parameter: csr - the graph to copy
+     */
+    HierarchyBuilder( const GraphCSR& csr ) : epoch(0) {
+
+        uint32_t numActors = csr.numActors();
+        uint32_t numNodes = numActors + csr.numMovies();
+        edges.resize( numNodes );
+        removed.resize( numNodes, false );
+        removedNeighbors.resize( numNodes, 0 );
+        witnessDist.resize( numNodes );
+        witnessSeen.resize( numNodes, 0 );
+        witnessTarget.resize( numNodes, 0 );
+        for( uint32_t movie = 0; movie < csr.numMovies(); movie++ ) {
+            const uint32_t* actorEnd = csr.actorsEnd( movie );
+            for( const uint32_t* actor = csr.actorsBegin( movie );
+                 actor != actorEnd; actor++ ) {
+                addEdge( *actor, numActors + movie,
+                         csr.movieWeights[movie], NO_MIDDLE );
+            }
+        }
+
+    }
+
+    /* Adds an edge in both directions, or makes the edge that is already
+     * there lighter
+     * Parameter: node1 - one end of the edge
+     * Parameter: node2 - the other end of the edge
+     * Parameter: weight - the weight of the edge
+     * Parameter: middle - the node a shortcut goes over, or NO_MIDDLE
+     */
+    void addEdge( uint32_t node1, uint32_t node2, uint32_t weight,
+                  uint32_t middle ) {
+
+        vector<HierarchyEdge>& list1 = edges[node1];
+        for( size_t i = 0; i < list1.size(); i++ ) {
+            if( list1[i].node != node2 ) { continue; }
+            if( weight < list1[i].weight ) {
+                list1[i].weight = weight;
+                list1[i].middle = middle;
+                vector<HierarchyEdge>& list2 = edges[node2];
+                for( size_t j = 0; j < list2.size(); j++ ) {
+                    if( list2[j].node != node1 ) { continue; }
+                    list2[j].weight = weight;
+                    list2[j].middle = middle;
+                }
+            }
+            return;
+        }
+        list1.push_back( HierarchyEdge{ node2, weight, middle } );
+        edges[node2].push_back( HierarchyEdge{ node1, weight, middle } );
+
+    }
+
+    /* Finds the shortcuts that removing a node needs. Two neighbors need
+     * one unless a witness search finds a path between them around the
+     * node that is no heavier than the path through it.
+     * Parameter: node - the node that would be removed
+     * Parameter: shortcuts - filled with the shortcuts it needs
+     * Parameter: neighbors - a list to hold the node's neighbors in
+     */
+    void findShortcuts( uint32_t node, vector<Shortcut>& shortcuts,
+                        vector<HierarchyEdge>& neighbors ) {
+
+        shortcuts.clear();
+        neighbors.clear();
+        for( size_t i = 0; i < edges[node].size(); i++ ) {
+            if( !removed[edges[node][i].node] ) {
+                neighbors.push_back( edges[node][i] );
+            }
+        }
+
+        //every pair is checked once, from its first neighbor
+        for( size_t i = 0; i + 1 < neighbors.size(); i++ ) {
+            uint32_t maxDist = 0;
+            for( size_t j = i + 1; j < neighbors.size(); j++ ) {
+                if( neighbors[j].weight > maxDist ) {
+                    maxDist = neighbors[j].weight;
+                }
+            }
+            maxDist += neighbors[i].weight;
+            witnessSearch( neighbors[i].node, node, maxDist, neighbors,
+                           i + 1 );
+            for( size_t j = i + 1; j < neighbors.size(); j++ ) {
+                uint32_t viaDist = neighbors[i].weight + neighbors[j].weight;
+                if( witness( neighbors[j].node ) <= viaDist ) { continue; }
+                shortcuts.push_back( Shortcut{ neighbors[i].node,
+                                               neighbors[j].node, viaDist } );
+            }
+        }
+
+    }
+
+  private:
+
+    //the distance of every node the current witness search reached
+    vector<uint32_t> witnessDist;
+    //the number of the witness search that last reached each node, and
+    //that each node is a target of
+    vector<uint32_t> witnessSeen;
+    vector<uint32_t> witnessTarget;
+    uint32_t epoch;
+
+    /* Returns the distance the last witness search found to a node */
+    uint32_t witness( uint32_t node ) const {
+        return witnessSeen[node] == epoch ? witnessDist[node] : (uint32_t)-1;
+    }
+
+    /* Runs Dijkstra's algorithm from a node over the nodes that are not
+     * removed, without going through the node being removed, until it has
+     * finished every target, passes maxDist or has finished
+     * WITNESS_SETTLE_LIMIT nodes
+     * Parameter: start - the node the search starts at
+     * Parameter: skip - the node being removed
+     * Parameter: maxDist - the longest distance worth searching
+     * Parameter: neighbors - the neighbors of the node being removed
+     * Parameter: firstTarget - the first of the neighbors that is a target
+     */
+    void witnessSearch( uint32_t start, uint32_t skip, uint32_t maxDist,
+                        const vector<HierarchyEdge>& neighbors,
+                        size_t firstTarget ) {
+
+        epoch++;
+        if( epoch == 0 ) {
+            std::fill( witnessSeen.begin(), witnessSeen.end(), 0 );
+            std::fill( witnessTarget.begin(), witnessTarget.end(), 0 );
+            epoch = 1;
+        }
+        size_t numTargets = neighbors.size() - firstTarget;
+        for( size_t j = firstTarget; j < neighbors.size(); j++ ) {
+            witnessTarget[neighbors[j].node] = epoch;
+        }
+        priority_queue<pair<uint32_t, uint32_t>,
+                       vector<pair<uint32_t, uint32_t>>,
+                       greater<pair<uint32_t, uint32_t>>> nodeQueue =
+            std::priority_queue<pair<uint32_t, uint32_t>,
+                                vector<pair<uint32_t, uint32_t>>,
+                                greater<pair<uint32_t, uint32_t>>>();
+        witnessSeen[start] = epoch;
+        witnessDist[start] = 0;
+        nodeQueue.push( pair<uint32_t, uint32_t>( 0, start ) );
+
+        uint32_t numSettled = 0;
+        while( !nodeQueue.empty() && numSettled < WITNESS_SETTLE_LIMIT ) {
+
+            uint32_t curDist = nodeQueue.top().first;
+            uint32_t curNode = nodeQueue.top().second;
+            nodeQueue.pop();
+            if( curDist > maxDist ) { break; }
+            if( curDist != witnessDist[curNode] ) { continue; }
+            numSettled++;
+            if( witnessTarget[curNode] == epoch ) {
+                witnessTarget[curNode] = 0;
+                if( --numTargets == 0 ) { break; }
+            }
+
+            const vector<HierarchyEdge>& list = edges[curNode];
+            for( size_t i = 0; i < list.size(); i++ ) {
+                uint32_t next = list[i].node;
+                if( next == skip || removed[next] ) { continue; }
+                uint32_t totalDist = curDist + list[i].weight;
+                if( totalDist >= witness( next ) ) { continue; }
+                witnessSeen[next] = epoch;
+                witnessDist[next] = totalDist;
+                nodeQueue.push( pair<uint32_t, uint32_t>( totalDist, next ) );
+            }
+
+        }
+
+    }
+
+};
+
+/**
+ * This method builds the hierarchy. Every node gets a priority of the
+ * number of shortcuts removing it would add, minus the edges it would take
+ * away, plus the number of its neighbors that are removed already so the
+ * removed nodes are spread out over the graph. The node with the lowest
+ * priority is removed next, after checking that its priority has not gone
+ * up since it was last found. In a graph without much of a hierarchy the
+ * nodes that are left get more and more connected and each one needs more
+ * shortcuts than the last, so once the next node would add more than
+ * CORE_EDGE_DIFFERENCE edges the rest become the core. The edges that go
+ * up in rank, shortcuts included, and the edges inside the core make up
+ * the hierarchy.
+ * Parameter: csr - the graph to build the hierarchy of
+ */
+void ContractionHierarchy::build( const GraphCSR& csr ) {
+
+    numActors = csr.numActors();
+    uint32_t numNodes = numActors + csr.numMovies();
+    HierarchyBuilder builder( csr );
+    vector<Shortcut> shortcuts = std::vector<Shortcut>();
+    vector<HierarchyEdge> neighbors = std::vector<HierarchyEdge>();
+
+    //find the first priority of every node
+    priority_queue<pair<int, uint32_t>, vector<pair<int, uint32_t>>,
+                   greater<pair<int, uint32_t>>> nodeQueue =
+        std::priority_queue<pair<int, uint32_t>, vector<pair<int, uint32_t>>,
+                            greater<pair<int, uint32_t>>>();
+    for( uint32_t node = 0; node < numNodes; node++ ) {
+        builder.findShortcuts( node, shortcuts, neighbors );
+        nodeQueue.push( pair<int, uint32_t>(
+            (int)shortcuts.size() - (int)neighbors.size(), node ) );
+    }
+
+    rank.assign( numNodes, 0 );
+    uint32_t nextRank = 0;
+    while( !nodeQueue.empty() ) {
+
+        uint32_t node = nodeQueue.top().second;
+        nodeQueue.pop();
+
+        //removing the other nodes may have made this one worse
+        builder.findShortcuts( node, shortcuts, neighbors );
+        int priority = (int)shortcuts.size() - (int)neighbors.size() +
+                       builder.removedNeighbors[node];
+        if( !nodeQueue.empty() && priority > nodeQueue.top().first ) {
+            nodeQueue.push( pair<int, uint32_t>( priority, node ) );
+            continue;
+        }
+
+        //the rest of the graph is too well connected to be worth removing
+        if( (int)shortcuts.size() - (int)neighbors.size() >
+            CORE_EDGE_DIFFERENCE ) {
+            break;
+        }
+
+        for( size_t i = 0; i < shortcuts.size(); i++ ) {
+            builder.addEdge( shortcuts[i].node1, shortcuts[i].node2,
+                             shortcuts[i].weight, node );
+        }
+        for( size_t i = 0; i < neighbors.size(); i++ ) {
+            builder.removedNeighbors[neighbors[i].node]++;
+        }
+        builder.removed[node] = true;
+        rank[node] = nextRank++;
+
+    }
+
+    //the nodes left over make up the core, ranked after all of the others
+    coreRank = nextRank;
+    for( uint32_t node = 0; node < numNodes; node++ ) {
+        if( !builder.removed[node] ) { rank[node] = nextRank++; }
+    }
+
+    //keep only the edges that go up in rank and the edges inside the core
+    upOffsets.assign( 1, 0 );
+    upTargets.clear();
+    upWeights.clear();
+    upMiddles.clear();
+    for( uint32_t node = 0; node < numNodes; node++ ) {
+        const vector<HierarchyEdge>& list = builder.edges[node];
+        for( size_t i = 0; i < list.size(); i++ ) {
+            bool inCore = rank[node] >= coreRank &&
+                          rank[list[i].node] >= coreRank;
+            if( rank[list[i].node] < rank[node] && !inCore ) { continue; }
+            upTargets.push_back( list[i].node );
+            upWeights.push_back( list[i].weight );
+            upMiddles.push_back( list[i].middle );
+        }
+        upOffsets.push_back( upTargets.size() );
+        vector<HierarchyEdge>().swap( builder.edges[node] );
+    }
+
+}
+
+/**
+ * This method unpacks an upward edge into the nodes of the path it stands
+ * for. The edge is kept by whichever end has the lower rank, and a
+ * shortcut goes over a node that was removed before both of its ends, so
+ * both halves of a shortcut are edges of that middle node.
+ * Parameter: node1 - the node the path comes from
+ * Parameter: node2 - the node at the other end of the edge
+ * Parameter: path - the nodes of the path so far
+ */
+void ContractionHierarchy::unpack( uint32_t node1, uint32_t node2,
+                                   vector<uint32_t>& path ) const {
+
+    uint32_t low = rank[node1] < rank[node2] ? node1 : node2;
+    uint32_t high = low == node1 ? node2 : node1;
+    uint32_t middle = NO_MIDDLE;
+    for( uint32_t i = upOffsets[low]; i < upOffsets[low + 1]; i++ ) {
+        if( upTargets[i] == high ) {
+            middle = upMiddles[i];
+            break;
+        }
+    }
+
+    if( middle == NO_MIDDLE ) {
+        path.push_back( node2 );
+        return;
+    }
+    unpack( node1, middle, path );
+    unpack( middle, node2, path );
+
+}
@@ -0,0 +1,81 @@
+/**
+ * This file defines a class that holds a contraction hierarchy of the
+ * weighted actor graph. Every actor and movie is given a rank, and the
+ * nodes are removed from the graph one at a time from the lowest rank up.
+ * Whenever removing a node would make two of its neighbors farther apart a
+ * shortcut between them is added, so a search that only ever goes up in
+ * rank from both ends still finds the lightest path.
+ * Author: Christian Kouris
+ * Email: ckouris@ucsd.edu
+ * Sources: Geisberger, Sanders, Schultes and Delling, Contraction
+ *          Hierarchies: Faster and Simpler Hierarchical Routing in Road
+ *          Networks; cplusplus doc for: std::vector, priority_queue
+ */
+#ifndef CONTRACTIONHIERARCHY_HPP
+#define CONTRACTIONHIERARCHY_HPP
+
+#include <cstdint>
+#include <vector>
+#include "GraphCSR.hpp"
+
+using namespace std;
+
+/* The ContractionHierarchy class works on the bipartite graph itself, with
+ * the actors as nodes 0 up to numActors and the movies as the nodes after
+ * them. Both edges of a movie weigh as much as the movie, so every path
+ * between two actors weighs exactly twice what it does in the actor graph.
+ * Nodes stop being removed once the next one would add too many shortcuts,
+ * and the nodes left over are the core, ranked last. Only the edges going
+ * up in rank and the edges between two core nodes are kept, in flat
+ * arrays: the edges of node n are upTargets[upOffsets[n]] up to
+ * upTargets[upOffsets[n + 1]], and each one is either an edge of the graph,
+ * with a middle of (uint32_t)-1, or a shortcut over the middle node it was
+ * added for.
+ */
+class ContractionHierarchy {
+
+  public:
+
+    //the number of actors, the first node that is a movie
+    uint32_t numActors;
+    //the rank of every node, the order the nodes were removed in
+    vector<uint32_t> rank;
+    //the rank of the first node of the core, the nodes left when removing
+    //more would add too many shortcuts, whose edges go both ways
+    uint32_t coreRank;
+    //where the upward edges of each node start, one extra at the end
+    vector<uint32_t> upOffsets;
+    //the node, weight and middle node of every upward edge
+    vector<uint32_t> upTargets;
+    vector<uint32_t> upWeights;
+    vector<uint32_t> upMiddles;
+
+    /* Constructor that initializes an empty hierarchy */
+    ContractionHierarchy() : numActors(0), coreRank(0), upOffsets(1, 0) {}
+
+    /* Returns whether the hierarchy was built for a graph with this many
+     * actors and movies */
+    bool covers( uint32_t actors, uint32_t movies ) const {
+        return numActors == actors && rank.size() == (size_t)actors + movies &&
+               actors > 0;
+    }
+
+    /* Builds the hierarchy of the graph. The node that adds the fewest
+     * shortcuts compared to the edges it takes away is removed next, until
+     * that would add too many more shortcuts than it takes away edges.
+     * Parameter: csr - the graph to build the hierarchy of
+     */
+    void build( const GraphCSR& csr );
+
+    /* Adds the nodes of the path an upward edge stands for to path, from
+     * the one after node1 up to node2
+     * Parameter: node1 - the node the path comes from
+     * Parameter: node2 - the node at the other end of the edge
+     * Parameter: path - the nodes of the path so far
+     */
+    void unpack( uint32_t node1, uint32_t node2,
+                 vector<uint32_t>& path ) const;
+
+};
+
+#endif  // CONTRACTIONHIERARCHY_HPP
@@ -0,0 +1,288 @@
+/* This file contains the methods of the DistanceOracle class, which builds
+ * the pruned landmark labels of the actors of a graph, answers distance
+ * queries with them and saves and loads them next to the graph.
+ * Author: Christian Kouris
+ * Email: ckouris@ucsd.edu
+ * Sources: Akiba, Iwata and Yoshida, Fast Exact Shortest-Path Distance
+ *          Queries on Large Networks by Pruned Landmark Labeling;
+ *          cplusplus documentation for: stable_sort, ofstream, memcmp
+ */
+
+#include "DistanceOracle.hpp"
+#include "MappedFile.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+//identifies an oracle file and the layout version it was written with
+static const char ORACLE_MAGIC[8] = { 'A', 'G', 'O', 'R', 'A', 'C', 'L',
+                                      'E' };
+static const uint32_t ORACLE_VERSION = 1;
+//the distance of an actor a search has not reached
+static const uint32_t NOT_REACHED = (uint32_t)-1;
+
+/* The fixed size header at the start of every oracle file. The size of the
+ * graph the labels belong to comes first, then the label offsets
+ * (numActors + 1 values of 64 bits), the hub of every entry (numEntries
+ * values of 32 bits) and the distance of every entry (numEntries values of
+ * 16 bits), all in the machine's byte order.
+ */
+struct OracleHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t numActors;
+    uint32_t numMovies;
+    uint32_t numCredits;
+    uint64_t numEntries;
+};
+
+/**
+ * This method builds the labels of every actor. The actors are ranked by
+ * their number of co-stars, and a breadth first search is run from each of
+ * them in that order. The search adds the rank and distance of its starting
+ * actor to the label of every actor it reaches, unless the labels from the
+ * earlier searches already give a distance that short, in which case it
+ * does not go past that actor. Since the well connected actors go first,
+ * most searches stop after a few steps.
+ * Parameter: csr - the graph to build the labels of
+ */
+void DistanceOracle::build( const GraphCSR& csr ) {
+
+    uint32_t numActors = csr.numActors();
+
+    //rank the actors by their number of co-stars, most first
+    vector<uint64_t> costars = std::vector<uint64_t>( numActors, 0 );
+    vector<uint32_t> order = std::vector<uint32_t>( numActors );
+    for( uint32_t actor = 0; actor < numActors; actor++ ) {
+        order[actor] = actor;
+        const uint32_t* movieEnd = csr.moviesEnd( actor );
+        for( const uint32_t* movie = csr.moviesBegin( actor );
+             movie != movieEnd; movie++ ) {
+            costars[actor] += csr.numActorsOf( *movie ) - 1;
+        }
+    }
+    std::stable_sort( order.begin(), order.end(),
+        [&costars]( uint32_t a1, uint32_t a2 ) {
+            return costars[a1] > costars[a2];
+        } );
+
+    //the labels grow one hub at a time, in order of rank
+    vector<vector<pair<uint32_t, uint16_t>>> labels =
+        std::vector<vector<pair<uint32_t, uint16_t>>>( numActors );
+    //the label of the current search's actor by hub, for pruning
+    vector<uint32_t> rootDist =
+        std::vector<uint32_t>( numActors, NOT_REACHED );
+    vector<uint32_t> actorDist =
+        std::vector<uint32_t>( numActors, NOT_REACHED );
+    vector<char> movieChecked = std::vector<char>( csr.numMovies(), false );
+    vector<uint32_t> reached = std::vector<uint32_t>();
+    vector<uint32_t> checked = std::vector<uint32_t>();
+
+    for( uint32_t rank = 0; rank < numActors; rank++ ) {
+
+        uint32_t root = order[rank];
+        const vector<pair<uint32_t, uint16_t>>& rootLabel = labels[root];
+        for( size_t i = 0; i < rootLabel.size(); i++ ) {
+            rootDist[rootLabel[i].first] = rootLabel[i].second;
+        }
+
+        //the reached list doubles as the queue of the search
+        actorDist[root] = 0;
+        reached.push_back( root );
+        for( size_t next = 0; next < reached.size(); next++ ) {
+
+            uint32_t curActor = reached[next];
+            uint32_t curDist = actorDist[curActor];
+
+            //stop here if an earlier hub already connects the two
+            const vector<pair<uint32_t, uint16_t>>& label = labels[curActor];
+            bool pruned = false;
+            for( size_t i = 0; i < label.size() && !pruned; i++ ) {
+                uint32_t hubDist = rootDist[label[i].first];
+                pruned = hubDist != NOT_REACHED &&
+                         hubDist + label[i].second <= curDist;
+            }
+            if( pruned ) { continue; }
+            labels[curActor].push_back(
+                pair<uint32_t, uint16_t>( rank, (uint16_t)curDist ) );
+
+            const uint32_t* movieEnd = csr.moviesEnd( curActor );
+            for( const uint32_t* movie = csr.moviesBegin( curActor );
+                 movie != movieEnd; movie++ ) {
+                if( movieChecked[*movie] ) { continue; }
+                movieChecked[*movie] = true;
+                checked.push_back( *movie );
+                const uint32_t* actorEnd = csr.actorsEnd( *movie );
+                for( const uint32_t* actor = csr.actorsBegin( *movie );
+                     actor != actorEnd; actor++ ) {
+                    if( actorDist[*actor] != NOT_REACHED ) { continue; }
+                    actorDist[*actor] = curDist + 1;
+                    reached.push_back( *actor );
+                }
+            }
+
+        }
+
+        //undo everything the search changed
+        for( size_t i = 0; i < reached.size(); i++ ) {
+            actorDist[reached[i]] = NOT_REACHED;
+        }
+        for( size_t i = 0; i < checked.size(); i++ ) {
+            movieChecked[checked[i]] = false;
+        }
+        for( size_t i = 0; i < labels[root].size(); i++ ) {
+            rootDist[labels[root][i].first] = NOT_REACHED;
+        }
+        reached.clear();
+        checked.clear();
+
+    }
+
+    //flatten the labels, each one is already sorted by hub
+    offsets.assign( 1, 0 );
+    hubs.clear();
+    dists.clear();
+    for( uint32_t actor = 0; actor < numActors; actor++ ) {
+        for( size_t i = 0; i < labels[actor].size(); i++ ) {
+            hubs.push_back( labels[actor][i].first );
+            dists.push_back( labels[actor][i].second );
+        }
+        offsets.push_back( hubs.size() );
+        //free each label as soon as it is copied
+        vector<pair<uint32_t, uint16_t>>().swap( labels[actor] );
+    }
+
+}
+
+/**
+ * This method finds the number of movies between two actors by walking
+ * both of their labels at once, which are sorted by hub, and taking the
+ * shortest way through a hub they share.
+ * Parameter: actor1 - the id of one actor
+ * Parameter: actor2 - the id of the other actor
+ */
+unsigned int DistanceOracle::distance( uint32_t actor1,
+                                       uint32_t actor2 ) const {
+
+    uint64_t i = offsets[actor1];
+    uint64_t iEnd = offsets[actor1 + 1];
+    uint64_t j = offsets[actor2];
+    uint64_t jEnd = offsets[actor2 + 1];
+    unsigned int best = (unsigned)-1;
+    while( i < iEnd && j < jEnd ) {
+        if( hubs[i] < hubs[j] ) {
+            i++;
+        } else if( hubs[j] < hubs[i] ) {
+            j++;
+        } else {
+            unsigned int total = (unsigned)dists[i] + dists[j];
+            if( total < best ) { best = total; }
+            i++;
+            j++;
+        }
+    }
+    return best;
+
+}
+
+/**
+ * This method writes the labels to a file that load can read back.
+ * Parameter: out_filename - the name of the file to write
+ * Parameter: csr - the graph the labels were built for
+ */
+bool DistanceOracle::save( const char* out_filename,
+                           const GraphCSR& csr ) const {
+
+    OracleHeader header;
+    memcpy( header.magic, ORACLE_MAGIC, sizeof(header.magic) );
+    header.version = ORACLE_VERSION;
+    header.numActors = csr.numActors();
+    header.numMovies = csr.numMovies();
+    header.numCredits = csr.numCredits();
+    header.numEntries = hubs.size();
+
+    ofstream out( out_filename, ios::binary );
+    if( !out ) {
+        cerr << "Failed to write " << out_filename << "!\n";
+        return false;
+    }
+    out.write( (const char*)&header, sizeof(header) );
+    out.write( (const char*)offsets.data(),
+               offsets.size() * sizeof(uint64_t) );
+    out.write( (const char*)hubs.data(), hubs.size() * sizeof(uint32_t) );
+    out.write( (const char*)dists.data(), dists.size() * sizeof(uint16_t) );
+    out.close();
+
+    if( !out ) {
+        cerr << "Failed to write " << out_filename << "!\n";
+        return false;
+    }
+    return true;
+
+}
+
+/**
+ * This method loads labels written by save. The file is mapped into memory,
+ * checked against the graph and copied into the oracle.
+ * Parameter: in_filename - the name of the file to load
+ * Parameter: csr - the graph the labels have to be built for
+ */
+bool DistanceOracle::load( const char* in_filename, const GraphCSR& csr ) {
+
+    MappedFile infile( in_filename );
+    const OracleHeader* header = (const OracleHeader*)infile.data();
+    if( !infile.isOpen() || infile.size() < sizeof(OracleHeader) ||
+        memcmp( header->magic, ORACLE_MAGIC, sizeof(header->magic) ) != 0 ||
+        header->version != ORACLE_VERSION ||
+        header->numActors != csr.numActors() ||
+        header->numMovies != csr.numMovies() ||
+        header->numCredits != csr.numCredits() ) {
+        cerr << "Failed to read " << in_filename << "!\n";
+        return false;
+    }
+
+    //the file has to be exactly as long as its sections
+    uint64_t numActors = header->numActors;
+    uint64_t numEntries = header->numEntries;
+    uint64_t expected = sizeof(OracleHeader) +
+                        (numActors + 1) * sizeof(uint64_t) +
+                        numEntries * (sizeof(uint32_t) + sizeof(uint16_t));
+    if( numEntries > infile.size() || infile.size() != expected ) {
+        cerr << "Failed to read " << in_filename << "!\n";
+        return false;
+    }
+    const char* cur = infile.data() + sizeof(OracleHeader);
+    vector<uint64_t> newOffsets = std::vector<uint64_t>( numActors + 1 );
+    vector<uint32_t> newHubs = std::vector<uint32_t>( numEntries );
+    vector<uint16_t> newDists = std::vector<uint16_t>( numEntries );
+    memcpy( newOffsets.data(), cur, newOffsets.size() * sizeof(uint64_t) );
+    cur += newOffsets.size() * sizeof(uint64_t);
+    memcpy( newHubs.data(), cur, newHubs.size() * sizeof(uint32_t) );
+    cur += newHubs.size() * sizeof(uint32_t);
+    memcpy( newDists.data(), cur, newDists.size() * sizeof(uint16_t) );
+
+    //make sure a damaged file can never index outside of the labels
+    bool valid = newOffsets[0] == 0 && newOffsets[numActors] == numEntries;
+    for( uint64_t i = 0; i < numActors && valid; i++ ) {
+        valid = newOffsets[i] <= newOffsets[i + 1];
+    }
+    for( uint64_t i = 0; i < numEntries && valid; i++ ) {
+        valid = newHubs[i] < numActors;
+    }
+    if( !valid ) {
+        cerr << "Failed to read " << in_filename << "!\n";
+        return false;
+    }
+
+    offsets.swap( newOffsets );
+    hubs.swap( newHubs );
+    dists.swap( newDists );
+    return true;
+
+}
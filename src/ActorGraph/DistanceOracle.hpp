@@ -0,0 +1,79 @@
+/**
+ * This file defines a class that answers how many movies apart two actors
+ * are without searching the graph. It is a pruned landmark labeling: every
+ * actor gets a short list of hub actors and its distance to each of them,
+ * built so that for any two actors that are connected, one of the hubs they
+ * have in common is on a shortest path between them.
+ * Author: Christian Kouris
+ * Email: ckouris@ucsd.edu
+ * Sources: Akiba, Iwata and Yoshida, Fast Exact Shortest-Path Distance
+ *          Queries on Large Networks by Pruned Landmark Labeling;
+ *          cplusplus doc for: std::vector, std::sort, ofstream
+ */
+#ifndef DISTANCEORACLE_HPP
+#define DISTANCEORACLE_HPP
+
+#include <cstdint>
+#include <vector>
+#include "GraphCSR.hpp"
+
+using namespace std;
+
+/* The DistanceOracle class holds the labels of every actor by dense id in
+ * flat arrays. The label of actor a is hubs[offsets[a]] up to
+ * hubs[offsets[a + 1]] with the distance to each hub in dists, sorted by
+ * hub. Hubs are numbered by rank, the order the actors were labeled in, so
+ * the actors with the most co-stars have the smallest numbers.
+ */
+class DistanceOracle {
+
+  public:
+
+    //where the label of each actor starts, one extra at the end
+    vector<uint64_t> offsets;
+    //the rank of every hub of every label, grouped by actor
+    vector<uint32_t> hubs;
+    //the number of movies between each actor and each of its hubs
+    vector<uint16_t> dists;
+
+    /* Constructor that initializes an empty oracle */
+    DistanceOracle() : offsets(1, 0) {}
+
+    /* Returns whether the oracle has labels for a graph with this many
+     * actors */
+    bool covers( uint32_t numActors ) const {
+        return offsets.size() == (size_t)numActors + 1 && numActors > 0;
+    }
+
+    /* Builds the labels of every actor in the graph. Actors are labeled
+     * one at a time from the most co-stars to the fewest, each with a
+     * breadth first search that stops at every actor whose distance the
+     * labels so far already give.
+     * Parameter: csr - the graph to build the labels of
+     */
+    void build( const GraphCSR& csr );
+
+    /* Returns the number of movies between two actors, or (unsigned)-1 if
+     * they are not connected
+     * Parameter: actor1 - the id of one actor
+     * Parameter: actor2 - the id of the other actor
+     */
+    unsigned int distance( uint32_t actor1, uint32_t actor2 ) const;
+
+    /* Writes the labels to a file. The size of the graph is saved with
+     * them so they are never loaded for a different graph.
+     * Parameter: out_filename - the name of the file to write
+     * Parameter: csr - the graph the labels were built for
+     */
+    bool save( const char* out_filename, const GraphCSR& csr ) const;
+
+    /* Loads labels written by save, returns false if the file is not a
+     * valid oracle for the given graph
+     * Parameter: in_filename - the name of the file to load
+     * Parameter: csr - the graph the labels have to be built for
+     */
+    bool load( const char* in_filename, const GraphCSR& csr );
+
+};
+
+#endif  // DISTANCEORACLE_HPP
@@ -0,0 +1,150 @@
+/**
+ * This file defines a hash index from names to dense ids that keeps every
+ * entry in one flat array. A lookup hashes the name once and then walks
+ * neighboring slots of the array, comparing the stored hash before it
+ * ever looks at a name, so most lookups touch a single cache line.
+ * Author: Christian Kouris
+ * Email: ckouris@ucsd.edu
+ * Sources: Knuth, The Art of Computer Programming Vol. 3, linear probing;
+ *          cplusplus doc for: std::vector, std::string_view, memcpy
+ */
+#ifndef FLATNAMEINDEX_HPP
+#define FLATNAMEINDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+/* The FlatNameIndex class is an open addressing hash table with linear
+ * probing. Each slot holds the hash of a name and the id it belongs to,
+ * the names themselves stay wherever the ids point to, so a lookup is
+ * given the hash of the name and a function that says whether an id is
+ * the one being looked for. The table is a power of two in size and at
+ * most half full. Hashes only depend on the bytes of the name, so a table
+ * can be saved and used again by a later run on the same machine.
+ */
+class FlatNameIndex {
+
+  public:
+
+    //the id of an empty slot, and what find returns for a missing name
+    static constexpr uint32_t NOT_FOUND = (uint32_t)-1;
+
+    /* One entry of the table */
+    struct Slot {
+        uint32_t hash;
+        uint32_t id;
+    };
+
+    //every slot of the table, empty ones have an id of NOT_FOUND
+    vector<Slot> slots;
+    //the number of slots that are not empty
+    uint32_t count;
+
+    /* Constructor that initializes an empty index */
+    FlatNameIndex() : count(0) {}
+
+    /* Returns the hash of a name, which mixes in eight bytes at a time.
+     * Two names that only differ by something else, like the year of a
+     * movie, can be told apart by giving that as the seed.
+     * Parameter: name - the name to hash
+     * Parameter: seed - a value mixed into the hash along with the name
+     */
+    static uint32_t hash( string_view name, uint32_t seed = 0 ) {
+
+        uint64_t h = 0x9e3779b97f4a7c15ULL ^ name.size() ^
+                     ((uint64_t)seed << 32);
+        size_t i = 0;
+        for( ; i + 8 <= name.size(); i += 8 ) {
+            uint64_t word;
+            memcpy( &word, name.data() + i, 8 );
+            h = (h ^ word) * 0xff51afd7ed558ccdULL;
+            h ^= h >> 32;
+        }
+        uint64_t rest = 0;
+        if( i < name.size() ) {
+            memcpy( &rest, name.data() + i, name.size() - i );
+        }
+        h = (h ^ rest) * 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 29;
+        return (uint32_t)(h ^ (h >> 32));
+
+    }
+
+    /* Returns the id of the entry with the given hash that equals accepts,
+     * or NOT_FOUND if there is none
+     * Parameter: hash - the hash of the name being looked for
+     * Parameter: equals - returns whether the name of an id is the one
+     *                     being looked for
+     */
+    template <typename Equals>
+    uint32_t find( uint32_t hash, Equals equals ) const {
+
+        if( slots.empty() ) { return NOT_FOUND; }
+        size_t mask = slots.size() - 1;
+        for( size_t i = hash & mask; ; i = (i + 1) & mask ) {
+            const Slot& slot = slots[i];
+            if( slot.id == NOT_FOUND ) { return NOT_FOUND; }
+            if( slot.hash == hash && equals( slot.id ) ) { return slot.id; }
+        }
+
+    }
+
+    /* Adds an id to the index, which must not be in it already
+     * Parameter: hash - the hash of the id's name
+     * Parameter: id - the id to add
+     */
+    void insert( uint32_t hash, uint32_t id ) {
+        if( ((size_t)count + 1) * 2 > slots.size() ) {
+            reserve( (size_t)count + 1 );
+        }
+        place( hash, id );
+        count++;
+    }
+
+    /* Makes the table big enough to hold numIds ids without growing
+     * Parameter: numIds - the number of ids the index will hold
+     */
+    void reserve( size_t numIds ) {
+
+        size_t capacity = slots.empty() ? 16 : slots.size();
+        while( capacity < numIds * 2 ) { capacity *= 2; }
+        if( capacity == slots.size() ) { return; }
+
+        vector<Slot> oldSlots = std::vector<Slot>( capacity,
+                                                   Slot{ 0, NOT_FOUND } );
+        oldSlots.swap( slots );
+        for( size_t i = 0; i < oldSlots.size(); i++ ) {
+            if( oldSlots[i].id != NOT_FOUND ) {
+                place( oldSlots[i].hash, oldSlots[i].id );
+            }
+        }
+
+    }
+
+    /* Returns the number of ids in the index */
+    size_t size() const { return count; }
+
+    /* Removes every id from the index */
+    void clear() {
+        slots.clear();
+        count = 0;
+    }
+
+  private:
+
+    /* Puts an id in the first empty slot at or after its hash */
+    void place( uint32_t hash, uint32_t id ) {
+        size_t mask = slots.size() - 1;
+        size_t i = hash & mask;
+        while( slots[i].id != NOT_FOUND ) { i = (i + 1) & mask; }
+        slots[i] = Slot{ hash, id };
+    }
+
+};
+
+#endif  // FLATNAMEINDEX_HPP
@@ -0,0 +1,174 @@
+/**
+ * This file defines a class that stores the connections between actors and
+ * movies in compressed sparse row form. Instead of every node owning its
+ * own vector of pointers, all of the movies of all of the actors live in
+ * one array of 32 bit movie ids and all of the actors of all of the movies
+ * live in another, with an offsets array saying where each node's range
+ * starts.
+ * Author: Christian Kouris
+ * Email: ckouris@ucsd.edu
+ * Sources: cplusplus doc for: std::vector, std::pair, counting sort
+ */
+#ifndef GRAPHCSR_HPP
+#define GRAPHCSR_HPP
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/* The GraphCSR class holds both directions of the bipartite actor/movie
+ * graph by dense id. The movies of actor a are actorMovies[actorOffsets[a]]
+ * up to actorMovies[actorOffsets[a + 1]], and the actors of a movie are
+ * found the same way in movieActors. The weight of every movie is kept next
+ * to the adjacency so weighted searches never have to touch a MovieNode.
+ */
+class GraphCSR {
+
+  public:
+
+    //where the range of each actor's movies starts, one extra at the end
+    vector<uint32_t> actorOffsets;
+    //the movie ids of every actor, grouped by actor
+    vector<uint32_t> actorMovies;
+    //where the range of each movie's actors starts, one extra at the end
+    vector<uint32_t> movieOffsets;
+    //the actor ids of every movie, grouped by movie
+    vector<uint32_t> movieActors;
+    //the weight of every movie by id
+    vector<uint32_t> movieWeights;
+    //the largest weight of any movie
+    uint32_t maxWeight;
+
+    /* Constructor that initializes an empty graph */
+    GraphCSR() : actorOffsets(1, 0), movieOffsets(1, 0), maxWeight(0) {}
+
+    /* Returns the number of actors in the graph */
+    uint32_t numActors() const { return actorOffsets.size() - 1; }
+
+    /* Returns the number of movies in the graph */
+    uint32_t numMovies() const { return movieOffsets.size() - 1; }
+
+    /* Returns the number of actor/movie credits in the graph */
+    uint32_t numCredits() const { return actorMovies.size(); }
+
+    /* Returns the first of the movie ids of an actor */
+    const uint32_t* moviesBegin( uint32_t actor ) const {
+        return actorMovies.data() + actorOffsets[actor];
+    }
+
+    /* Returns one past the last of the movie ids of an actor */
+    const uint32_t* moviesEnd( uint32_t actor ) const {
+        return actorMovies.data() + actorOffsets[actor + 1];
+    }
+
+    /* Returns the first of the actor ids of a movie */
+    const uint32_t* actorsBegin( uint32_t movie ) const {
+        return movieActors.data() + movieOffsets[movie];
+    }
+
+    /* Returns one past the last of the actor ids of a movie */
+    const uint32_t* actorsEnd( uint32_t movie ) const {
+        return movieActors.data() + movieOffsets[movie + 1];
+    }
+
+    /* Returns the number of movies an actor was in */
+    uint32_t numMoviesOf( uint32_t actor ) const {
+        return actorOffsets[actor + 1] - actorOffsets[actor];
+    }
+
+    /* Returns the number of actors that were in a movie */
+    uint32_t numActorsOf( uint32_t movie ) const {
+        return movieOffsets[movie + 1] - movieOffsets[movie];
+    }
+
+    /* Adds a batch of credits to the graph. Every node keeps its existing
+     * neighbors first and gets the new ones after them in the order of the
+     * batch, which is a stable counting sort of the credits by actor and
+     * by movie. Nodes with ids past the current counts are created.
+     * Parameter: newActors - the number of actors after the batch
+     * Parameter: weights - the weight of every movie after the batch
+     * Parameter: credits - the (actor id, movie id) pairs to add
+     */
+    void append( uint32_t newActors, const vector<uint32_t>& weights,
+                 const vector<pair<uint32_t, uint32_t>>& credits ) {
+
+        vector<uint32_t> actorCounts = std::vector<uint32_t>( newActors, 0 );
+        vector<uint32_t> movieCounts =
+            std::vector<uint32_t>( weights.size(), 0 );
+        for( size_t i = 0; i < credits.size(); i++ ) {
+            actorCounts[credits[i].first]++;
+            movieCounts[credits[i].second]++;
+        }
+        appendSide( actorOffsets, actorMovies, actorCounts, credits, true );
+        appendSide( movieOffsets, movieActors, movieCounts, credits, false );
+        setWeights( weights );
+
+    }
+
+    /* Replaces the weight of every movie
+     * Parameter: weights - the weight of every movie by id
+     */
+    void setWeights( const vector<uint32_t>& weights ) {
+
+        movieWeights = weights;
+        maxWeight = 0;
+        for( size_t i = 0; i < movieWeights.size(); i++ ) {
+            if( movieWeights[i] > maxWeight ) { maxWeight = movieWeights[i]; }
+        }
+
+    }
+
+  private:
+
+    /* Rebuilds one direction of the graph with the new credits placed
+     * after each node's existing neighbors
+     * Parameter: offsets - the offsets of the direction being rebuilt
+     * Parameter: neighbors - the neighbor ids of the direction
+     * Parameter: counts - how many new neighbors each node gets
+     * Parameter: credits - the credits being added
+     * Parameter: byActor - whether this is the actor to movie direction
+     */
+    static void appendSide( vector<uint32_t>& offsets,
+                            vector<uint32_t>& neighbors,
+                            const vector<uint32_t>& counts,
+                            const vector<pair<uint32_t, uint32_t>>& credits,
+                            bool byActor ) {
+
+        uint32_t oldNodes = offsets.size() - 1;
+        vector<uint32_t> newOffsets =
+            std::vector<uint32_t>( counts.size() + 1, 0 );
+        for( uint32_t i = 0; i < counts.size(); i++ ) {
+            uint32_t oldDegree = i < oldNodes ? offsets[i + 1] - offsets[i]
+                                              : 0;
+            newOffsets[i + 1] = newOffsets[i] + oldDegree + counts[i];
+        }
+
+        //copy the old ranges over and remember where the new ones go
+        vector<uint32_t> newNeighbors =
+            std::vector<uint32_t>( newOffsets.back() );
+        vector<uint32_t> next = std::vector<uint32_t>( counts.size() );
+        for( uint32_t i = 0; i < counts.size(); i++ ) {
+            uint32_t pos = newOffsets[i];
+            if( i < oldNodes ) {
+                for( uint32_t j = offsets[i]; j < offsets[i + 1]; j++ ) {
+                    newNeighbors[pos++] = neighbors[j];
+                }
+            }
+            next[i] = pos;
+        }
+        for( size_t i = 0; i < credits.size(); i++ ) {
+            uint32_t node = byActor ? credits[i].first : credits[i].second;
+            uint32_t other = byActor ? credits[i].second : credits[i].first;
+            newNeighbors[next[node]++] = other;
+        }
+
+        offsets.swap( newOffsets );
+        neighbors.swap( newNeighbors );
+
+    }
+
+};
+
+#endif  // GRAPHCSR_HPP
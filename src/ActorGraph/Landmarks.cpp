@@ -0,0 +1,127 @@
+/* This file contains the methods of the Landmarks class, which picks the
+ * landmark actors of a graph and finds their weighted distance to every
+ * other actor.
+ * Author: Christian Kouris
+ * Email: ckouris@ucsd.edu
+ * Sources: Goldberg and Harrelson, Computing the Shortest Path: A* Search
+ *          Meets Graph Theory; cplusplus documentation for: priority_queue
+ */
+
+#include "Landmarks.hpp"
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/* Finds the weighted distance from one actor to every actor with Dijkstra's
+ * algorithm. The queue holds (distance, actor) pairs and a pair is skipped
+ * if its actor was finished with a shorter distance already.
+ * Parameter: csr - the graph to search
+ * Parameter: startActor - the actor every distance is measured from
+ * Parameter: actorDist - filled with the distance of every actor
+ */
+static void distancesFrom( const GraphCSR& csr, uint32_t startActor,
+                           vector<uint32_t>& actorDist ) {
+
+    actorDist.assign( csr.numActors(), (uint32_t)-1 );
+    vector<char> movieChecked = std::vector<char>( csr.numMovies(), false );
+    priority_queue<pair<uint32_t, uint32_t>,
+                   vector<pair<uint32_t, uint32_t>>,
+                   greater<pair<uint32_t, uint32_t>>> actorQueue =
+        std::priority_queue<pair<uint32_t, uint32_t>,
+                            vector<pair<uint32_t, uint32_t>>,
+                            greater<pair<uint32_t, uint32_t>>>();
+    actorDist[startActor] = 0;
+    actorQueue.push( pair<uint32_t, uint32_t>( 0, startActor ) );
+
+    while( !actorQueue.empty() ) {
+
+        uint32_t curDist = actorQueue.top().first;
+        uint32_t curActor = actorQueue.top().second;
+        actorQueue.pop();
+        if( curDist != actorDist[curActor] ) { continue; }
+
+        //actors come out in order of distance, so the first one to reach
+        //a movie gives all of its actors their shortest way through it
+        const uint32_t* movieEnd = csr.moviesEnd( curActor );
+        for( const uint32_t* movie = csr.moviesBegin( curActor );
+             movie != movieEnd; movie++ ) {
+            if( movieChecked[*movie] ) { continue; }
+            movieChecked[*movie] = true;
+            uint32_t totalDist = curDist + csr.movieWeights[*movie];
+            const uint32_t* actorEnd = csr.actorsEnd( *movie );
+            for( const uint32_t* actor = csr.actorsBegin( *movie );
+                 actor != actorEnd; actor++ ) {
+                if( totalDist >= actorDist[*actor] ) { continue; }
+                actorDist[*actor] = totalDist;
+                actorQueue.push(
+                    pair<uint32_t, uint32_t>( totalDist, *actor ) );
+            }
+        }
+
+    }
+
+}
+
+/**
+ * This method picks the landmarks and fills in their distances. Landmarks
+ * far away from each other at the edges of the graph give the best bounds,
+ * so after the first one every landmark is the actor whose closest landmark
+ * is the farthest away. Only actors the first landmark reaches are picked,
+ * and fewer landmarks are picked if every such actor is a landmark already.
+ * Parameter: csr - the graph to pick the landmarks from
+ * Parameter: numLandmarks - the number of landmarks to pick
+ */
+void Landmarks::build( const GraphCSR& csr, unsigned int numLandmarks ) {
+
+    uint32_t numActors = csr.numActors();
+    actors.clear();
+    dists.clear();
+    if( numActors == 0 || numLandmarks == 0 ) { return; }
+
+    //the first landmark is the actor in the most movies
+    uint32_t next = 0;
+    for( uint32_t actor = 1; actor < numActors; actor++ ) {
+        if( csr.numMoviesOf( actor ) > csr.numMoviesOf( next ) ) {
+            next = actor;
+        }
+    }
+
+    //the distances of each landmark, and of each actor to its closest one
+    vector<vector<uint32_t>> landmarkDists =
+        std::vector<vector<uint32_t>>();
+    vector<uint32_t> closest =
+        std::vector<uint32_t>( numActors, (uint32_t)-1 );
+    while( actors.size() < numLandmarks ) {
+
+        actors.push_back( next );
+        landmarkDists.push_back( std::vector<uint32_t>() );
+        distancesFrom( csr, next, landmarkDists.back() );
+
+        uint32_t farthest = 0;
+        for( uint32_t actor = 0; actor < numActors; actor++ ) {
+            uint32_t dist = landmarkDists.back()[actor];
+            if( dist < closest[actor] ) { closest[actor] = dist; }
+            if( closest[actor] != (uint32_t)-1 &&
+                closest[actor] > farthest ) {
+                farthest = closest[actor];
+                next = actor;
+            }
+        }
+        //every reachable actor is on top of a landmark already
+        if( farthest == 0 ) { break; }
+
+    }
+
+    //store the distances by actor so a bound reads one row
+    dists.resize( (size_t)numActors * actors.size() );
+    for( uint32_t actor = 0; actor < numActors; actor++ ) {
+        for( size_t i = 0; i < actors.size(); i++ ) {
+            dists[actor * actors.size() + i] = landmarkDists[i][actor];
+        }
+    }
+
+}
@@ -0,0 +1,74 @@
+/**
+ * This file defines a class that holds the weighted distance from a few
+ * landmark actors to every actor in the graph. By the triangle inequality
+ * the distance between two actors is at least the difference of their
+ * distances to any landmark, which gives an A* search a lower bound on how
+ * far every actor still is from the one it is looking for.
+ * Author: Christian Kouris
+ * Email: ckouris@ucsd.edu
+ * Sources: Goldberg and Harrelson, Computing the Shortest Path: A* Search
+ *          Meets Graph Theory; cplusplus doc for: std::vector,
+ *          priority_queue
+ */
+#ifndef LANDMARKS_HPP
+#define LANDMARKS_HPP
+
+#include <cstdint>
+#include <vector>
+#include "GraphCSR.hpp"
+
+using namespace std;
+
+/* The Landmarks class holds the distances of every actor by dense id. The
+ * distances of actor a to each landmark are next to each other, starting at
+ * dists[a * actors.size()], so a bound only reads one small row per actor.
+ * Actors a landmark cannot reach are (uint32_t)-1 away from it.
+ */
+class Landmarks {
+
+  public:
+
+    //the id of every landmark actor, in the order they were picked
+    vector<uint32_t> actors;
+    //the weighted distance from every landmark to every actor, by actor
+    vector<uint32_t> dists;
+
+    /* Picks numLandmarks landmarks and finds their distance to every
+     * actor. The first one is the actor in the most movies and every next
+     * one is the actor farthest from all of the landmarks so far.
+     * Parameter: csr - the graph to pick the landmarks from
+     * Parameter: numLandmarks - the number of landmarks to pick
+     */
+    void build( const GraphCSR& csr, unsigned int numLandmarks );
+
+    /* Returns a lower bound on the weighted distance between two actors,
+     * which is (uint32_t)-1 if some landmark shows they are not connected
+     * and 0 if there are no landmarks
+     * Parameter: actor - the actor the bound is measured from
+     * Parameter: target - the actor the bound is measured to
+     */
+    uint32_t bound( uint32_t actor, uint32_t target ) const {
+
+        size_t numLandmarks = actors.size();
+        const uint32_t* actorRow = dists.data() + actor * numLandmarks;
+        const uint32_t* targetRow = dists.data() + target * numLandmarks;
+        uint32_t best = 0;
+        for( size_t i = 0; i < numLandmarks; i++ ) {
+            //a landmark that reaches only one of them separates them
+            if( (actorRow[i] == (uint32_t)-1) !=
+                (targetRow[i] == (uint32_t)-1) ) {
+                return (uint32_t)-1;
+            }
+            if( actorRow[i] == (uint32_t)-1 ) { continue; }
+            uint32_t diff = actorRow[i] > targetRow[i]
+                                ? actorRow[i] - targetRow[i]
+                                : targetRow[i] - actorRow[i];
+            if( diff > best ) { best = diff; }
+        }
+        return best;
+
+    }
+
+};
+
+#endif  // LANDMARKS_HPP
@@ -0,0 +1,237 @@
+/**
+ * This file defines a forest of trees that can be joined and split at any
+ * edge while still answering which trees two nodes are in and what the
+ * largest key on the path between them is, all in logarithmic time. It is
+ * used to keep a spanning forest up to date as new edges are added.
+ * Author: Christian Kouris
+ * Email: ckouris@ucsd.edu
+ * Sources: Sleator and Tarjan, A Data Structure for Dynamic Trees;
+ *          cplusplus doc for: std::vector, std::swap
+ */
+#ifndef LINKCUTTREE_HPP
+#define LINKCUTTREE_HPP
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/* The LinkCutTree class keeps every tree of the forest as a set of paths,
+ * each held in a splay tree ordered by depth. access brings the path from
+ * a node up to the root of its tree into one splay tree, and a node can be
+ * made the root of its tree by reversing that path. Every node has a key,
+ * and every splay tree node knows the node with the largest key below it,
+ * so the largest key on a path is read off after one access. Nodes are
+ * dense ids from add, and the splay trees are kept in flat arrays.
+ */
+template <typename Key>
+class LinkCutTree {
+
+  public:
+
+    //the id of a missing parent or child
+    static constexpr uint32_t NO_NODE = (uint32_t)-1;
+
+    /* Adds a node that is a tree of its own and returns its id
+     * Parameter: key - the key of the node
+     */
+    uint32_t add( const Key& key ) {
+        parent.push_back( NO_NODE );
+        left.push_back( NO_NODE );
+        right.push_back( NO_NODE );
+        flipped.push_back( false );
+        keys.push_back( key );
+        largest.push_back( (uint32_t)( keys.size() - 1 ) );
+        return (uint32_t)( keys.size() - 1 );
+    }
+
+    /* Gives a node that is a tree of its own a new key
+     * Parameter: node - a node with no edges
+     * Parameter: key - the new key of the node
+     */
+    void reset( uint32_t node, const Key& key ) {
+        flipped[node] = false;
+        keys[node] = key;
+        largest[node] = node;
+    }
+
+    /* Returns the key of a node */
+    const Key& key( uint32_t node ) const { return keys[node]; }
+
+    /* Returns the number of nodes */
+    size_t size() const { return keys.size(); }
+
+    /* Returns the root of the tree a node is in */
+    uint32_t findRoot( uint32_t node ) {
+        access( node );
+        uint32_t root = node;
+        push( root );
+        while( left[root] != NO_NODE ) {
+            root = left[root];
+            push( root );
+        }
+        splay( root );
+        return root;
+    }
+
+    /* Returns whether two nodes are in the same tree */
+    bool connected( uint32_t node1, uint32_t node2 ) {
+        return node1 == node2 || findRoot( node1 ) == findRoot( node2 );
+    }
+
+    /* Adds an edge between two nodes that are in different trees
+     * Parameter: node1 - the first node of the edge
+     * Parameter: node2 - the second node of the edge
+     */
+    void link( uint32_t node1, uint32_t node2 ) {
+        makeRoot( node1 );
+        parent[node1] = node2;
+    }
+
+    /* Removes the edge between two nodes
+     * Parameter: node1 - the first node of the edge
+     * Parameter: node2 - the second node of the edge
+     */
+    void cut( uint32_t node1, uint32_t node2 ) {
+        makeRoot( node1 );
+        access( node2 );
+        //node1 is now the only node above node2 on its path
+        left[node2] = NO_NODE;
+        parent[node1] = NO_NODE;
+        update( node2 );
+    }
+
+    /* Returns the node with the largest key on the path between two nodes
+     * in the same tree, both ends included
+     * Parameter: node1 - one end of the path
+     * Parameter: node2 - the other end of the path
+     */
+    uint32_t pathLargest( uint32_t node1, uint32_t node2 ) {
+        makeRoot( node1 );
+        access( node2 );
+        return largest[node2];
+    }
+
+  private:
+
+    //the parent of every node, either in its splay tree or, for the root
+    //of a splay tree, the node above its path
+    vector<uint32_t> parent;
+    //the children of every node in its splay tree
+    vector<uint32_t> left;
+    vector<uint32_t> right;
+    //whether the children below a node still have to be swapped
+    vector<bool> flipped;
+    //the key of every node
+    vector<Key> keys;
+    //the node with the largest key in the splay tree below every node
+    vector<uint32_t> largest;
+    //the nodes from a splay tree root down to the node being splayed
+    vector<uint32_t> splayPath;
+
+    /* Returns whether a node is the root of its splay tree */
+    bool isSplayRoot( uint32_t node ) const {
+        uint32_t up = parent[node];
+        return up == NO_NODE || ( left[up] != node && right[up] != node );
+    }
+
+    /* Swaps the children of a node that has a reversal waiting */
+    void push( uint32_t node ) {
+        if( !flipped[node] ) { return; }
+        std::swap( left[node], right[node] );
+        if( left[node] != NO_NODE ) {
+            flipped[left[node]] = !flipped[left[node]];
+        }
+        if( right[node] != NO_NODE ) {
+            flipped[right[node]] = !flipped[right[node]];
+        }
+        flipped[node] = false;
+    }
+
+    /* Finds the largest key below a node from its children */
+    void update( uint32_t node ) {
+        uint32_t best = node;
+        if( left[node] != NO_NODE && keys[best] < keys[largest[left[node]]] ) {
+            best = largest[left[node]];
+        }
+        if( right[node] != NO_NODE &&
+            keys[best] < keys[largest[right[node]]] ) {
+            best = largest[right[node]];
+        }
+        largest[node] = best;
+    }
+
+    /* Moves a node above its parent in their splay tree */
+    void rotate( uint32_t node ) {
+
+        uint32_t up = parent[node];
+        uint32_t top = parent[up];
+        if( !isSplayRoot( up ) ) {
+            if( left[top] == up ) { left[top] = node; }
+            else { right[top] = node; }
+        }
+        parent[node] = top;
+        if( left[up] == node ) {
+            left[up] = right[node];
+            if( right[node] != NO_NODE ) { parent[right[node]] = up; }
+            right[node] = up;
+        } else {
+            right[up] = left[node];
+            if( left[node] != NO_NODE ) { parent[left[node]] = up; }
+            left[node] = up;
+        }
+        parent[up] = node;
+        update( up );
+        update( node );
+
+    }
+
+    /* Moves a node to the root of its splay tree */
+    void splay( uint32_t node ) {
+
+        //reversals are passed down from the root before anything moves
+        splayPath.clear();
+        splayPath.push_back( node );
+        for( uint32_t up = node; !isSplayRoot( up ); up = parent[up] ) {
+            splayPath.push_back( parent[up] );
+        }
+        for( size_t i = splayPath.size(); i > 0; i-- ) {
+            push( splayPath[i - 1] );
+        }
+
+        while( !isSplayRoot( node ) ) {
+            uint32_t up = parent[node];
+            if( !isSplayRoot( up ) ) {
+                bool sameSide = ( left[up] == node ) ==
+                                ( left[parent[up]] == up );
+                rotate( sameSide ? up : node );
+            }
+            rotate( node );
+        }
+
+    }
+
+    /* Makes the path from the root of its tree down to a node one splay
+     * tree with the node at its root and nothing deeper on it */
+    void access( uint32_t node ) {
+        uint32_t below = NO_NODE;
+        for( uint32_t cur = node; cur != NO_NODE; cur = parent[cur] ) {
+            splay( cur );
+            right[cur] = below;
+            update( cur );
+            below = cur;
+        }
+        splay( node );
+    }
+
+    /* Makes a node the root of its tree */
+    void makeRoot( uint32_t node ) {
+        access( node );
+        flipped[node] = !flipped[node];
+        push( node );
+    }
+
+};
+
+#endif  // LINKCUTTREE_HPP
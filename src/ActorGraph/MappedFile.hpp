@@ -0,0 +1,87 @@
+/**
+ * This file defines a small class that maps a whole file into memory so that
+ * the loaders can scan the bytes of the file in place instead of copying
+ * every line into a string first.
+ * Author: Christian Kouris
+ * Email: ckouris@ucsd.edu
+ * Sources: man pages for: mmap, munmap, open, fstat, madvise
+ */
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstddef>
+
+/* The MappedFile class opens a file read only and maps it into memory for
+ * the lifetime of the object. The mapping is released when the object is
+ * destroyed, so the pointer returned by data() must not outlive it. An empty
+ * file is a valid open file with a size of 0 and no data.
+ */
+class MappedFile {
+
+  private:
+
+    //start of the mapping and the number of bytes in it
+    const char* bytes;
+    size_t length;
+    //whether the file could be opened at all
+    bool opened;
+
+  public:
+
+    /* Constructor that opens and maps the file
+     * Parameter: filename - the name of the file that will be mapped
+     */
+    explicit MappedFile( const char* filename )
+        : bytes(0), length(0), opened(false) {
+
+        int fd = open( filename, O_RDONLY );
+        if( fd < 0 ) { return; }
+
+        struct stat info;
+        if( fstat( fd, &info ) != 0 ) {
+            close( fd );
+            return;
+        }
+
+        length = (size_t)info.st_size;
+        if( length > 0 ) {
+            void* mapping = mmap( 0, length, PROT_READ, MAP_PRIVATE, fd, 0 );
+            if( mapping == MAP_FAILED ) {
+                length = 0;
+                close( fd );
+                return;
+            }
+            //the loaders read the file front to back exactly once
+            madvise( mapping, length, MADV_SEQUENTIAL );
+            bytes = (const char*)mapping;
+        }
+        //the mapping stays valid after the descriptor is closed
+        close( fd );
+        opened = true;
+
+    }
+
+    /* Destructor that unmaps the file */
+    ~MappedFile() {
+        if( bytes != 0 ) { munmap( (void*)bytes, length ); }
+    }
+
+    MappedFile( const MappedFile& ) = delete;
+    MappedFile& operator=( const MappedFile& ) = delete;
+
+    /* Returns whether the file was opened and mapped successfully */
+    bool isOpen() const { return opened; }
+
+    /* Returns a pointer to the first byte of the file */
+    const char* data() const { return bytes; }
+
+    /* Returns the number of bytes in the file */
+    size_t size() const { return length; }
+
+};
+
+#endif  // MAPPEDFILE_HPP
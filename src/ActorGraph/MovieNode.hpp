@@ -9,50 +9,34 @@
 #ifndef MOVIENODE_HPP
 #define MOVIENODE_HPP
 
-#include <string>
-#include <vector>
-#include "ActorNode.hpp"
+#include <string_view>
 
 using namespace std;
 
 /* The MovieNode class represents an edge in the graph of actors. The class
- * itself holds all of the actors that were in the movie as well as the name
- * and year of the movie. All the other members of the class are used to help 
- * with the search algorithms.
+ * itself holds the name, year and weight of the movie, the actors that were
+ * in it are stored by id in the graph's GraphCSR. Like ActorNode it holds
+ * no search state.
  */
 class MovieNode {
 
   public:
     
-    //name and year of the movie
-    string name; 
+    //name and year of the movie, the name is a view of the graph's
+    //StringPool
+    string_view name;
     unsigned int year;
-    //list of each actor in the movie and their pointers 
-    vector<ActorNode*> actors;
-    //previous ActorNode* in the BFS
-    ActorNode* previous;
-    //has been checked in the BFS already
-    bool checked;
+    //dense id of the movie, its index in the graph's list of movies
+    unsigned int id;
     //the weight of the edge which will be 2019 - year + 1
     unsigned int weight;
-    //the connecting ActorNodes in a tree
-    vector<pair<ActorNode*,ActorNode*>> actorPairs;
 
     /* Constructor that initializes the MovieNode */
-    MovieNode(string name, unsigned int year) : name(name), year(year) {
-        actors = std::vector<ActorNode*>();
-        previous = 0;
-        checked = false;
+    MovieNode(string_view name, unsigned int year, unsigned int id = 0)
+        : name(name), year(year), id(id) {
         weight = 1 + 2019 - year;
-        actorPairs = std::vector<pair<ActorNode*,ActorNode*>>();
     }
 
 };
 
-struct CompareWeight {
-    bool operator()( const MovieNode* m1, const MovieNode* m2 ) {
-        return m1->weight < m2->weight;
-    }
-};
-
 #endif  // MOVIENODE_HPP
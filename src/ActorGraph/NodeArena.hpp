@@ -0,0 +1,125 @@
+/**
+ * This file defines a class that creates the actor and movie nodes of a
+ * graph in a few large blocks instead of one allocation per node. Nodes
+ * made one after another sit next to each other in memory, and the whole
+ * graph's nodes are freed a block at a time when the arena goes away.
+ * Author: Christian Kouris
+ * Email: ckouris@ucsd.edu
+ * Sources: cplusplus doc for: placement new, operator new,
+ *          std::is_trivially_destructible, std::forward
+ */
+#ifndef NODEARENA_HPP
+#define NODEARENA_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/* The NodeArena class owns every node it creates. Each block holds a run
+ * of nodes in the order they were created, and a block is never moved or
+ * grown, so a pointer to a node stays good until the arena is cleared.
+ * Blocks start small and double up to MAX_BLOCK_NODES so a small graph
+ * wastes little, and reserve makes one block big enough for a number of
+ * nodes known ahead of time. Nodes that need no destructor are freed with
+ * their block without visiting each one.
+ */
+template <typename T>
+class NodeArena {
+
+  public:
+
+    //the nodes in the first block and the most in any block that grows
+    static constexpr size_t MIN_BLOCK_NODES = 1024;
+    static constexpr size_t MAX_BLOCK_NODES = 65536;
+
+    /* Constructor that initializes an empty arena */
+    NodeArena() : numNodes(0), nextBlockNodes(MIN_BLOCK_NODES) {}
+
+    /* Every node belongs to exactly one arena */
+    NodeArena( const NodeArena& ) = delete;
+    NodeArena& operator=( const NodeArena& ) = delete;
+
+    /* Destructor that frees every node */
+    ~NodeArena() { clear(); }
+
+    /* Creates a node in the arena with the given constructor arguments
+     * Parameter: args - the arguments passed on to the node's constructor
+     */
+    template <typename... Args>
+    T* create( Args&&... args ) {
+
+        if( blocks.empty() || blocks.back().used == blocks.back().capacity ) {
+            addBlock( nextBlockNodes );
+            if( nextBlockNodes < MAX_BLOCK_NODES ) { nextBlockNodes *= 2; }
+        }
+        Block& block = blocks.back();
+        T* node = new ( block.nodes + block.used )
+            T( std::forward<Args>( args )... );
+        block.used++;
+        numNodes++;
+        return node;
+
+    }
+
+    /* Makes sure the next count nodes are created next to each other,
+     * starting a new block for them if the current one is too small
+     * Parameter: count - the number of nodes about to be created
+     */
+    void reserve( size_t count ) {
+        if( count > 0 && ( blocks.empty() ||
+            blocks.back().capacity - blocks.back().used < count ) ) {
+            addBlock( count );
+        }
+    }
+
+    /* Returns the number of nodes in the arena */
+    size_t size() const { return numNodes; }
+
+    /* Frees every node and block in the arena */
+    void clear() {
+
+        for( size_t i = 0; i < blocks.size(); i++ ) {
+            if( !std::is_trivially_destructible<T>::value ) {
+                for( size_t j = 0; j < blocks[i].used; j++ ) {
+                    blocks[i].nodes[j].~T();
+                }
+            }
+            ::operator delete( blocks[i].nodes );
+        }
+        blocks.clear();
+        numNodes = 0;
+        nextBlockNodes = MIN_BLOCK_NODES;
+
+    }
+
+  private:
+
+    /* A run of memory for capacity nodes, of which the first used exist */
+    struct Block {
+        T* nodes;
+        size_t capacity;
+        size_t used;
+    };
+
+    //every block in the order they were made, the last one is being filled
+    vector<Block> blocks;
+    //the number of nodes in every block together
+    size_t numNodes;
+    //the capacity of the next block that is not reserved
+    size_t nextBlockNodes;
+
+    /* Starts a new block that holds capacity nodes */
+    void addBlock( size_t capacity ) {
+        Block block = { static_cast<T*>(
+                            ::operator new( capacity * sizeof(T) ) ),
+                        capacity, 0 };
+        blocks.push_back( block );
+    }
+
+};
+
+#endif  // NODEARENA_HPP
@@ -0,0 +1,364 @@
+/**
+ * This file defines a class that holds all of the state a single search
+ * through the ActorGraph needs. The graph itself is never changed by a
+ * search, so every thread that wants to search the same graph at the same
+ * time just needs its own QueryContext.
+ * Author: Christian Kouris
+ * Email: ckouris@ucsd.edu
+ * Sources: cplusplus doc for: std::vector, std::fill, priority_queue
+ *          comparators
+ */
+#ifndef QUERYCONTEXT_HPP
+#define QUERYCONTEXT_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ActorNode.hpp"
+
+using namespace std;
+
+//marks a previous actor or movie that has not been set
+static const uint32_t NO_ID = (uint32_t)-1;
+
+/* The QueryContext class holds the search state of every actor and movie by
+ * dense id. The arrays are sized to the graph the first time the context is
+ * used and are reused by every search after that. Instead of clearing the
+ * arrays between searches, every search gets a new epoch number and an
+ * entry only counts for the current search if its stamp equals that epoch,
+ * so starting a new search never has to walk what the last one touched.
+ */
+class QueryContext {
+
+  public:
+
+    //the movie each seen actor was reached through
+    vector<uint32_t> actorPrevious;
+    //distance of each seen actor from the starting actor
+    vector<unsigned int> actorDist;
+    //the number of links each seen actor has with the searched actor
+    vector<unsigned int> actorLinks;
+    //the actor each checked movie was reached from
+    vector<uint32_t> moviePrevious;
+    //the movie each actor seen from the end of a bidirectional search
+    //leads through and the actor each movie checked from the end leads to
+    vector<uint32_t> actorNext;
+    vector<uint32_t> movieNext;
+    //distance of each actor seen from the end of a bidirectional search
+    vector<unsigned int> actorDistBack;
+    //the landmark bound on the distance left to the end of an A* search
+    //of each seen actor
+    vector<unsigned int> actorBound;
+    //the actors waiting at each distance of a bucket queue search, by
+    //distance modulo the number of buckets
+    vector<vector<uint32_t>> distBuckets;
+    //the distance of every actor and movie from the start and from the end
+    //of a contraction hierarchy search, actors first and then movies, and
+    //the node each one was reached from on that side
+    vector<unsigned int> nodeDist;
+    vector<unsigned int> nodeDistBack;
+    vector<uint32_t> nodePrevious;
+    vector<uint32_t> nodeNext;
+    //one bit per actor and per movie marking the frontier of a direction
+    //optimizing search, every bit is clear again once the search ends
+    vector<uint64_t> actorBits;
+    vector<uint64_t> movieBits;
+    //the searches of a multi source search that have reached every actor
+    //and movie, and the ones that reach it on the next level, every mask
+    //is clear again once the search ends
+    vector<uint64_t> actorSearches;
+    vector<uint64_t> actorSearchesNext;
+    vector<uint64_t> movieSearches;
+    vector<uint64_t> movieSearchesNext;
+    //the actors a multi source search reached on every level, the
+    //searches that reached each of them there and where each level starts
+    //in the lists
+    vector<uint32_t> levelActors;
+    vector<uint64_t> levelMasks;
+    vector<size_t> levelStarts;
+    //the last entry of every actor in the lists, NO_ID once the search
+    //ends, and for every entry the one of the same actor on an earlier
+    //level
+    vector<uint32_t> actorEntries;
+    vector<uint32_t> earlierEntries;
+    //the movies a multi source search reached
+    vector<uint32_t> reachedMovies;
+    //the number of the current search, stamps equal to it are current
+    uint32_t epoch;
+
+    /* Constructor that initializes an empty context */
+    QueryContext() : epoch(0) {}
+
+    /* Gets the context ready for a new search on a graph with the given
+     * number of actors and movies. Everything the last search marked is
+     * forgotten by moving on to the next epoch.
+     * Parameter: numActors - the number of actors in the graph
+     * Parameter: numMovies - the number of movies in the graph
+     */
+    void begin( uint32_t numActors, uint32_t numMovies ) {
+
+        //once the counter wraps the old stamps could match again
+        epoch++;
+        if( epoch == 0 ) {
+            std::fill( actorSeen.begin(), actorSeen.end(), 0 );
+            std::fill( actorChecked.begin(), actorChecked.end(), 0 );
+            std::fill( movieChecked.begin(), movieChecked.end(), 0 );
+            std::fill( actorSeenBack.begin(), actorSeenBack.end(), 0 );
+            std::fill( actorCheckedBack.begin(), actorCheckedBack.end(), 0 );
+            std::fill( movieCheckedBack.begin(), movieCheckedBack.end(), 0 );
+            std::fill( actorTarget.begin(), actorTarget.end(), 0 );
+            std::fill( nodeSeen.begin(), nodeSeen.end(), 0 );
+            std::fill( nodeSeenBack.begin(), nodeSeenBack.end(), 0 );
+            epoch = 1;
+        }
+
+        //new entries start with a stamp of 0, which is never current
+        if( actorSeen.size() < numActors ) {
+            actorPrevious.resize( numActors );
+            actorDist.resize( numActors );
+            actorLinks.resize( numActors );
+            actorBound.resize( numActors );
+            actorSeen.resize( numActors, 0 );
+            actorChecked.resize( numActors, 0 );
+            actorNext.resize( numActors );
+            actorDistBack.resize( numActors );
+            actorSeenBack.resize( numActors, 0 );
+            actorCheckedBack.resize( numActors, 0 );
+            actorTarget.resize( numActors, 0 );
+        }
+        if( movieChecked.size() < numMovies ) {
+            moviePrevious.resize( numMovies );
+            movieChecked.resize( numMovies, 0 );
+            movieNext.resize( numMovies );
+            movieCheckedBack.resize( numMovies, 0 );
+        }
+        actorBits.resize( (numActors + 63) / 64, 0 );
+        movieBits.resize( (numMovies + 63) / 64, 0 );
+
+    }
+
+    /* Gets the context ready for a new multi source search, which only
+     * uses the masks and lists of its own
+     * Parameter: numActors - the number of actors in the graph
+     * Parameter: numMovies - the number of movies in the graph
+     */
+    void beginMultiSource( uint32_t numActors, uint32_t numMovies ) {
+
+        if( actorSearches.size() < numActors ) {
+            actorSearches.resize( numActors, 0 );
+            actorSearchesNext.resize( numActors, 0 );
+            actorEntries.resize( numActors, NO_ID );
+        }
+        if( movieSearches.size() < numMovies ) {
+            movieSearches.resize( numMovies, 0 );
+            movieSearchesNext.resize( numMovies, 0 );
+        }
+        levelActors.clear();
+        levelMasks.clear();
+        levelStarts.clear();
+        earlierEntries.clear();
+        reachedMovies.clear();
+
+    }
+
+    /* Gets the context ready for a new contraction hierarchy search, which
+     * also needs the arrays that hold actors and movies together
+     * Parameter: numActors - the number of actors in the graph
+     * Parameter: numMovies - the number of movies in the graph
+     */
+    void beginNodes( uint32_t numActors, uint32_t numMovies ) {
+
+        begin( numActors, numMovies );
+        size_t numNodes = (size_t)numActors + numMovies;
+        if( nodeSeen.size() < numNodes ) {
+            nodeDist.resize( numNodes );
+            nodeDistBack.resize( numNodes );
+            nodePrevious.resize( numNodes );
+            nodeNext.resize( numNodes );
+            nodeSeen.resize( numNodes, 0 );
+            nodeSeenBack.resize( numNodes, 0 );
+        }
+
+    }
+
+    /* Returns the distance of a node from the start of a contraction
+     * hierarchy search, which is infinite if it has not been reached */
+    unsigned int distOfNode( uint32_t node ) const {
+        return nodeSeen[node] == epoch ? nodeDist[node] : (unsigned)-1;
+    }
+
+    /* Returns the distance of a node from the end of a contraction
+     * hierarchy search, which is infinite if it has not been reached */
+    unsigned int distOfNodeBack( uint32_t node ) const {
+        return nodeSeenBack[node] == epoch ? nodeDistBack[node]
+                                           : (unsigned)-1;
+    }
+
+    /* Gives a node a distance from the start of a contraction hierarchy
+     * search
+     * Parameter: node - the node that was reached
+     * Parameter: dist - its distance from the start
+     * Parameter: previous - the node it was reached from
+     */
+    void reachNode( uint32_t node, unsigned int dist, uint32_t previous ) {
+        nodeSeen[node] = epoch;
+        nodeDist[node] = dist;
+        nodePrevious[node] = previous;
+    }
+
+    /* Gives a node a distance from the end of a contraction hierarchy
+     * search
+     * Parameter: node - the node that was reached
+     * Parameter: dist - its distance from the end
+     * Parameter: next - the node it was reached from
+     */
+    void reachNodeBack( uint32_t node, unsigned int dist, uint32_t next ) {
+        nodeSeenBack[node] = epoch;
+        nodeDistBack[node] = dist;
+        nodeNext[node] = next;
+    }
+
+    /* Returns whether the current search has seen an actor yet */
+    bool isActorSeen( uint32_t actor ) const {
+        return actorSeen[actor] == epoch;
+    }
+
+    /* Marks an actor as seen by the current search and gives it no previous
+     * movie, an infinite distance and no links */
+    void seeActor( uint32_t actor ) {
+        actorSeen[actor] = epoch;
+        actorPrevious[actor] = NO_ID;
+        actorDist[actor] = (unsigned)-1;
+        actorLinks[actor] = 0;
+    }
+
+    /* Returns whether the current search has checked an actor already */
+    bool isActorChecked( uint32_t actor ) const {
+        return actorChecked[actor] == epoch;
+    }
+
+    /* Marks an actor as checked by the current search */
+    void checkActor( uint32_t actor ) { actorChecked[actor] = epoch; }
+
+    /* Returns whether the current search has checked a movie already */
+    bool isMovieChecked( uint32_t movie ) const {
+        return movieChecked[movie] == epoch;
+    }
+
+    /* Marks a movie as checked by the current search and records the actor
+     * it was reached from
+     * Parameter: movie - the movie being checked
+     * Parameter: previous - the actor the movie was reached from
+     */
+    void checkMovie( uint32_t movie, uint32_t previous ) {
+        movieChecked[movie] = epoch;
+        moviePrevious[movie] = previous;
+    }
+
+    /* Returns whether the end side of a bidirectional search has seen an
+     * actor yet */
+    bool isActorSeenBack( uint32_t actor ) const {
+        return actorSeenBack[actor] == epoch;
+    }
+
+    /* Marks an actor as seen from the end side of a bidirectional search
+     * Parameter: actor - the actor that was reached
+     * Parameter: next - the movie that leads from it towards the end
+     */
+    void seeActorBack( uint32_t actor, uint32_t next ) {
+        actorSeenBack[actor] = epoch;
+        actorNext[actor] = next;
+    }
+
+    /* Returns whether the end side of a bidirectional search has checked
+     * an actor already */
+    bool isActorCheckedBack( uint32_t actor ) const {
+        return actorCheckedBack[actor] == epoch;
+    }
+
+    /* Marks an actor as checked from the end side of a bidirectional
+     * search */
+    void checkActorBack( uint32_t actor ) { actorCheckedBack[actor] = epoch; }
+
+    /* Returns whether the end side of a bidirectional search has checked a
+     * movie already */
+    bool isMovieCheckedBack( uint32_t movie ) const {
+        return movieCheckedBack[movie] == epoch;
+    }
+
+    /* Marks a movie as checked from the end side of a bidirectional search
+     * Parameter: movie - the movie being checked
+     * Parameter: next - the actor that leads from it towards the end
+     */
+    void checkMovieBack( uint32_t movie, uint32_t next ) {
+        movieCheckedBack[movie] = epoch;
+        movieNext[movie] = next;
+    }
+
+    /* Marks an actor as one that the current search is looking for */
+    void markTarget( uint32_t actor ) { actorTarget[actor] = epoch; }
+
+    /* Returns whether the current search is still looking for an actor */
+    bool isTarget( uint32_t actor ) const {
+        return actorTarget[actor] == epoch;
+    }
+
+    /* Marks an actor as one the current search has found already */
+    void unmarkTarget( uint32_t actor ) { actorTarget[actor] = 0; }
+
+    /* Returns the distance of an actor, which is infinite if it has not
+     * been seen by the current search */
+    unsigned int dist( uint32_t actor ) const {
+        return isActorSeen( actor ) ? actorDist[actor] : (unsigned)-1;
+    }
+
+    /* Returns the distance of an actor from the end of a bidirectional
+     * search, which is infinite if the end side has not seen it */
+    unsigned int distBack( uint32_t actor ) const {
+        return isActorSeenBack( actor ) ? actorDistBack[actor] : (unsigned)-1;
+    }
+
+    /* Returns the links of an actor, which is 0 if it has not been seen by
+     * the current search */
+    unsigned int links( uint32_t actor ) const {
+        return isActorSeen( actor ) ? actorLinks[actor] : 0;
+    }
+
+  private:
+
+    //the epoch each actor was last seen and checked in, and each movie
+    //was last checked in
+    vector<uint32_t> actorSeen;
+    vector<uint32_t> actorChecked;
+    vector<uint32_t> movieChecked;
+    //the same stamps for the end side of a bidirectional search
+    vector<uint32_t> actorSeenBack;
+    vector<uint32_t> actorCheckedBack;
+    vector<uint32_t> movieCheckedBack;
+    //the epoch of the search each actor is a target of
+    vector<uint32_t> actorTarget;
+    //the epoch each node of a contraction hierarchy search was last
+    //reached from the start and from the end in
+    vector<uint32_t> nodeSeen;
+    vector<uint32_t> nodeSeenBack;
+
+};
+
+/* Orders actor ids by their number of links, most links first, and then by
+ * name */
+struct CompareLinks {
+    const QueryContext& context;
+    const vector<ActorNode*>& actors;
+    bool operator()( uint32_t a1, uint32_t a2 ) const {
+
+        if( context.actorLinks[a1] == context.actorLinks[a2] ) {
+            return actors[a1]->name < actors[a2]->name;
+        }
+
+        return context.actorLinks[a2] < context.actorLinks[a1];
+
+    }
+};
+
+#endif  // QUERYCONTEXT_HPP
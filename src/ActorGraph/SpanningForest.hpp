@@ -0,0 +1,149 @@
+/**
+ * This file defines the smallest spanning forest of the movie graph in a
+ * form that can be kept up to date as new credits are added, so the trees
+ * of a growing database never have to be built again from the start.
+ * Author: Christian Kouris
+ * Email: ckouris@ucsd.edu
+ * Sources: Sleator and Tarjan, A Data Structure for Dynamic Trees;
+ *          cplusplus doc for: std::vector
+ */
+#ifndef SPANNINGFOREST_HPP
+#define SPANNINGFOREST_HPP
+
+#include <cstdint>
+#include <vector>
+#include "LinkCutTree.hpp"
+
+using namespace std;
+
+/* One edge of a movie tree. Every movie joins the rest of its cast to the
+ * first actor of its cast, so actor1 is always that first actor and place
+ * is where actor2 is in the cast of the movie. */
+struct ForestEdge {
+    uint32_t movie;
+    uint32_t place;
+    uint32_t actor1;
+    uint32_t actor2;
+    bool operator==( const ForestEdge& other ) const {
+        return movie == other.movie && place == other.place &&
+               actor1 == other.actor1 && actor2 == other.actor2;
+    }
+};
+
+/* The order edges are taken in by Kruskal's algorithm, lightest movie
+ * first, then by movie id and by place in the cast. No two edges have the
+ * same key, so there is exactly one smallest forest for any graph. */
+struct ForestKey {
+    uint32_t weight;
+    uint32_t movie;
+    uint32_t place;
+    bool operator<( const ForestKey& other ) const {
+        if( weight != other.weight ) { return weight < other.weight; }
+        if( movie != other.movie ) { return movie < other.movie; }
+        return place < other.place;
+    }
+};
+
+/* The tree edges an update of a forest added and took out. An edge that
+ * was added and then taken out by the same update is in neither. */
+struct ForestChanges {
+    vector<ForestEdge> added;
+    vector<ForestEdge> removed;
+};
+
+/* The SpanningForest class holds the edges of a smallest spanning forest
+ * as nodes of a link cut tree between the nodes of their two actors, so
+ * the heaviest edge on the path between any two actors can be found
+ * quickly. It also remembers how much of every movie's cast and of the
+ * graph's list of movies that got credits it has seen, so an update only
+ * has to look at the credits added since. It is built
+ * and updated by the ActorGraph it belongs to.
+ */
+class SpanningForest {
+
+  public:
+
+    //the actor and edge nodes of the trees, actor nodes have the
+    //smallest key so the heaviest node of a path is always an edge
+    LinkCutTree<ForestKey> tree;
+    //the tree node of every actor id that has been seen
+    vector<uint32_t> actorNodes;
+    //the edge of every tree node that is an edge, and whether it is one
+    vector<ForestEdge> nodeEdges;
+    vector<bool> isEdge;
+    //the number of actors of every movie that have been seen
+    vector<uint32_t> castSeen;
+    //how many of the graph's touched movies have been seen
+    size_t touchedSeen;
+    //the tree nodes of edges that were taken out, free to be used again
+    vector<uint32_t> freeNodes;
+    //the number of edges in the forest
+    size_t numEdges;
+
+    /* Constructor that initializes an empty forest */
+    SpanningForest() : touchedSeen(0), numEdges(0) {}
+
+    /* Returns the number of edges in the forest */
+    size_t size() const { return numEdges; }
+
+    /* Returns the number of trees in the forest, one for every actor that
+     * is not joined to another */
+    size_t numTrees() const { return actorNodes.size() - numEdges; }
+
+    /* Adds the next actor id to the forest as a tree of its own */
+    void addActor() {
+        actorNodes.push_back( tree.add( ForestKey{ 0, 0, 0 } ) );
+        nodeEdges.resize( tree.size() );
+        isEdge.resize( tree.size(), false );
+    }
+
+    /* Adds an edge between two actors in different trees and returns the
+     * tree node of the edge
+     * Parameter: edge - the edge to add
+     * Parameter: key - the key of the edge
+     */
+    uint32_t addEdge( const ForestEdge& edge, const ForestKey& key ) {
+
+        uint32_t node;
+        if( freeNodes.empty() ) {
+            node = tree.add( key );
+            nodeEdges.resize( tree.size() );
+            isEdge.resize( tree.size(), false );
+        } else {
+            node = freeNodes.back();
+            freeNodes.pop_back();
+            tree.reset( node, key );
+        }
+        nodeEdges[node] = edge;
+        isEdge[node] = true;
+        tree.link( actorNodes[edge.actor1], node );
+        tree.link( node, actorNodes[edge.actor2] );
+        numEdges++;
+        return node;
+
+    }
+
+    /* Takes an edge out of the forest, splitting its tree in two
+     * Parameter: node - the tree node of the edge
+     */
+    void removeEdge( uint32_t node ) {
+        tree.cut( actorNodes[nodeEdges[node].actor1], node );
+        tree.cut( node, actorNodes[nodeEdges[node].actor2] );
+        isEdge[node] = false;
+        freeNodes.push_back( node );
+        numEdges--;
+    }
+
+    /* Returns every edge of the forest, in no particular order */
+    vector<ForestEdge> edges() const {
+        vector<ForestEdge> forestEdges = std::vector<ForestEdge>();
+        forestEdges.reserve( numEdges );
+        for( size_t i = 0; i < isEdge.size(); i++ ) {
+            if( isEdge[i] ) { forestEdges.push_back( nodeEdges[i] ); }
+        }
+        return forestEdges;
+    }
+
+};
+
+#endif  // SPANNINGFOREST_HPP
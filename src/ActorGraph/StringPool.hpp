@@ -0,0 +1,92 @@
+/**
+ * This file defines a class that keeps one copy of every actor and movie
+ * name of a graph packed into a few large blocks of text. The nodes and the
+ * lookup maps of the graph all hold views into the pool instead of their
+ * own strings, so a name is stored once and never allocated on its own.
+ * Author: Christian Kouris
+ * Email: ckouris@ucsd.edu
+ * Sources: cplusplus doc for: std::string_view, std::unique_ptr, memcpy
+ */
+#ifndef STRINGPOOL_HPP
+#define STRINGPOOL_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+/* The StringPool class copies each string it is given to the end of its
+ * current block and returns a view of the copy. A block is never moved or
+ * grown, so every view stays good until the pool is cleared. A string that
+ * does not fit in what is left of the current block starts a new one of
+ * BLOCK_BYTES, or one just big enough for it if it is longer than that.
+ */
+class StringPool {
+
+  public:
+
+    //the size of every block that is not reserved for a longer string
+    static constexpr size_t BLOCK_BYTES = 1 << 20;
+
+    /* Constructor that initializes an empty pool */
+    StringPool() : blockUsed(0), blockSize(0), numBytes(0) {}
+
+    /* Every name belongs to exactly one pool */
+    StringPool( const StringPool& ) = delete;
+    StringPool& operator=( const StringPool& ) = delete;
+
+    /* Copies a string into the pool and returns a view of the copy
+     * Parameter: str - the string to copy
+     */
+    string_view add( string_view str ) {
+
+        if( blockSize - blockUsed < str.size() ) {
+            reserve( str.size() > BLOCK_BYTES ? str.size() : BLOCK_BYTES );
+        }
+        char* copy = blocks.empty() ? 0 : blocks.back().get() + blockUsed;
+        if( !str.empty() ) { memcpy( copy, str.data(), str.size() ); }
+        blockUsed += str.size();
+        numBytes += str.size();
+        return string_view( copy, str.size() );
+
+    }
+
+    /* Makes sure the next bytes bytes of strings go into one block,
+     * starting a new block for them if the current one is too small
+     * Parameter: bytes - the number of bytes about to be added
+     */
+    void reserve( size_t bytes ) {
+        if( bytes > 0 && blockSize - blockUsed < bytes ) {
+            blocks.push_back( unique_ptr<char[]>( new char[bytes] ) );
+            blockUsed = 0;
+            blockSize = bytes;
+        }
+    }
+
+    /* Returns the number of bytes of strings in the pool */
+    size_t size() const { return numBytes; }
+
+    /* Frees every string in the pool */
+    void clear() {
+        blocks.clear();
+        blockUsed = 0;
+        blockSize = 0;
+        numBytes = 0;
+    }
+
+  private:
+
+    //every block in the order they were made, the last one is being filled
+    vector<unique_ptr<char[]>> blocks;
+    //the bytes used and the bytes there are in the last block
+    size_t blockUsed;
+    size_t blockSize;
+    //the bytes of every string in the pool together
+    size_t numBytes;
+
+};
+
+#endif  // STRINGPOOL_HPP
@@ -1,84 +1,112 @@
 /**
  * This data structure is used primarily to support both the union and
- * the find functions for disjointed sets. The find function will take an
- * element of type ActorNode* and fins the set that it belongs to. The union
+ * the find functions for disjointed sets. The find function will take the
+ * id of an actor and fins the set that it belongs to. The union
  * function will take two sets and combine them into one.
  * Author: Christian Kouris
  * Email: ckouris@ucsd.edu
- * Sources: cplusplus doc for: std::unordered_map, std::string, 
- *          foward declaration
+ * Sources: cplusplus doc for: std::vector;
+ *          Tarjan and van Leeuwen, Worst-Case Analysis of Set Union
+ *          Algorithms, path halving
  */
 #ifndef UNIONFIND_HPP
 #define UNIONFIND_HPP
 
-#include "ActorNode.hpp"
+#include <cstdint>
+#include <vector>
 
 using namespace std;
 
 /* The UnionFind class only has the unite and the find functions. The
- * constructor does nothing and there are no member variables. The find
- * function finds a set that an element belongs to and the unite function
- * combines two sets.
+ * constructor puts every id from 0 up to numIds in a set of its own. The
+ * find function finds a set that an element belongs to and the unite
+ * function combines two sets, the smaller set always going under the
+ * root of the bigger one. The parent and size of every id are kept in
+ * flat arrays here, so building a tree never changes the graph, and the
+ * number of sets is kept up to date so it never has to be counted.
  */
 class UnionFind {
 
+  private:
+
+    //the parent of every id in its tree, a root is its own parent
+    vector<uint32_t> parent;
+    //size of the tree of every root
+    vector<uint32_t> sizes;
+    //the number of sets there are
+    uint32_t numSets;
+
   public:
-    
-    /* Constructor that initializes the UnionFind */
-    UnionFind() {}
-   
-    /* The find function checks to see which set an ActorNode belongs to 
-     * by searching for it's root. The root defines what set the node is in.
-     * At the start of the tree finding each node is its own root in which
-     * case their parent is set to 0. This progrm also sets node's parents
-     * parent to be root to make union more efficient.
-     * Parameter: node - the ActorNode that we want to find the set of
-     */
-    ActorNode* find( ActorNode* node ){
 
-        //finds the root
-        ActorNode* root = node;
-        while( root->parent != 0 ) {
-            root = root->parent;
+    /* Constructor that initializes the UnionFind
+     * Parameter: numIds - the number of ids in the sets
+     */
+    UnionFind( uint32_t numIds )
+        : parent(numIds), sizes(numIds, 1), numSets(numIds) {
+        for( uint32_t i = 0; i < numIds; i++ ) {
+            parent[i] = i;
         }
-        //make all the parent nodes of node point to root
-        ActorNode* curNode = node;
-        while( curNode != root ) {
-            ActorNode* tmp = curNode->parent;
-            curNode->parent = root;
-            curNode = tmp;
+    }
+
+    /* The find function checks to see which set an id belongs to by
+     * searching for it's root. The root defines what set the id is in.
+     * At the start each id is its own root in which case it is its own
+     * parent. Every id passed on the way up is pointed at its grandparent,
+     * which halves the path for the next find without a second pass.
+     * Parameter: node - the id that we want to find the set of
+     */
+    uint32_t find( uint32_t node ) {
+
+        while( parent[node] != node ) {
+            parent[node] = parent[parent[node]];
+            node = parent[node];
         }
-        return root;
+        return node;
 
     }
-    
-    /* unite takes in two actornodes, finds the roots and then combines
-     * the sets that the two ActorNodes were in into a single set. unite 
-     * relies on the find function in order to find the sets to concatinate.
-     * When the program is done, it returns the root to the new set that was
-     * created.
-     * Parameter: The first actornode we want to combine into a set
-     * Parameter: The second actornode we want to combine into a set
+
+    /* unite takes in two ids, finds the roots and then combines the sets
+     * that the two ids were in into a single set, with the root of the
+     * bigger set as the root of both.
+     * Parameter: a1 - the first id we want to combine into a set
+     * Parameter: a2 - the second id we want to combine into a set
+     * Returns: true if the two ids were in different sets before
      */
-    ActorNode* unite( ActorNode* a1, ActorNode* a2 ) {
+    bool unite( uint32_t a1, uint32_t a2 ) {
 
-        ActorNode* root1 = find( a1 );
-        ActorNode* root2 = find( a2 );
+        uint32_t root1 = find( a1 );
+        uint32_t root2 = find( a2 );
         //check to see if they are in the same tree
-        if( root1 == root2 ) { return root1; }
-
-        //else set one root to be the other's root
-        if( root1->size < root2->size ) {
-            root1->parent = root2;
-            root2->size += root1->size;
-            return root2;
-        } else {
-            root2->parent = a1;
-            root1->size += root2->size;
-            return root1;
+        if( root1 == root2 ) { return false; }
+
+        //else set the smaller root's parent to be the bigger root
+        if( sizes[root1] < sizes[root2] ) {
+            uint32_t tmp = root1;
+            root1 = root2;
+            root2 = tmp;
         }
+        parent[root2] = root1;
+        sizes[root1] += sizes[root2];
+        numSets--;
+        return true;
+
+    }
 
+    /* Returns whether two ids are in the same set
+     * Parameter: a1 - the first id
+     * Parameter: a2 - the second id
+     */
+    bool connected( uint32_t a1, uint32_t a2 ) {
+        return find( a1 ) == find( a2 );
     }
 
+    /* Returns the number of ids in the set of an id
+     * Parameter: node - any id in the set
+     */
+    uint32_t size( uint32_t node ) { return sizes[find( node )]; }
+
+    /* Returns the number of sets there are */
+    uint32_t count() const { return numSets; }
+
 };
 #endif  // UNIONFIND_HPP
@@ -0,0 +1,79 @@
+/**
+ * This file writes a Bacon number report for a list of actors. For every
+ * actor it counts how many other actors are one movie away, two movies away
+ * and so on, using the direction optimizing search from the ActorGraph
+ * class.
+ * Author: Christian Kouris
+ * Email: ckouris@ucsd.edu
+ * Sources: loadFromFile implementation, docs for ofstream and ifstream
+ */
+
+#include "ActorGraph.hpp"
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/* This is the main driver for the baconnumbers program. This takes in a file
+ * to create the graph, a file of actors to measure from and the output file.
+ * Each line of the output is an actor followed by the number of actors at
+ * each distance from it, starting with the actor itself at distance 0.
+ * Parameter: argc - the number of arguments passed into the command line
+ * Parameter: argv - a list of all of the arguments passed in
+ */
+int main( int argc, char* argv[] ) {
+
+    //check to see if there are exactly 3 arguments
+    if( argc != 4 ) {
+        cerr << "Usage: " << argv[0]
+             << " <database> <actors.tsv> <outfile>" << endl;
+        return 1;
+    }
+
+    //build the graph using the first argument passed as the file
+    ActorGraph actorGraph = ActorGraph();
+    if( !actorGraph.load( argv[1], 0 ) ) { return 1; }
+    ifstream actorfile(argv[2]);
+    ofstream outfile(argv[3]);
+
+    //print the header to the outfile
+    outfile << "Actor\tActors at distance 0,1,2,..." << endl;
+
+    //loop through each actor and print its counts
+    bool header = true;
+    while (actorfile) {
+        string actor;
+        // get the next line
+        if (!getline(actorfile, actor)){ break; }
+        //skip the header
+        if (header){ 
+            header = false; 
+            continue; 
+        }
+
+        //count the actors at each distance
+        vector<unsigned int> actorDist = actorGraph.findActorDistances( actor );
+        vector<unsigned int> counts = std::vector<unsigned int>();
+        for( unsigned int i = 0; i < actorDist.size(); i++ ) {
+            if( actorDist[i] == (unsigned)-1 ) { continue; }
+            if( actorDist[i] >= counts.size() ) {
+                counts.resize( actorDist[i] + 1, 0 );
+            }
+            counts[actorDist[i]]++;
+        }
+
+        string countStr = actor + '\t';
+        for( unsigned int i = 0; i < counts.size(); i++ ) {
+            countStr += (i == 0 ? "" : ",") + to_string( counts[i] );
+        }
+        outfile << countStr << endl;
+
+    }
+
+    actorfile.close();
+    outfile.close();
+    return 0;
+
+}
@@ -0,0 +1,99 @@
+/**
+ * This file answers actor distance queries with the distance oracle of the
+ * ActorGraph class. The oracle is loaded from the given file when it was
+ * saved for the same graph, otherwise it is built and saved there, so every
+ * run after the first one only has to load it.
+ * Author: Christian Kouris
+ * Email: ckouris@ucsd.edu
+ * Sources: loadFromFile implementation, pathfinder
+ */
+
+#include "ActorGraph.hpp"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/* This is the main driver of the distance oracle. It takes in the database
+ * file, the oracle file, the file of pairs of actors and the output file,
+ * and optionally "d" to write the distance of every pair or "p" to write a
+ * shortest path of every pair like pathfinder does. Distances are the
+ * default, with -1 for actors that are not connected.
+ * Parameter: argc - the number of arguments passed in + the function name
+ * Parameter: argv - the list of arguments that were passed in.
+ */
+int main( int argc, char* argv[] ) {
+
+    //check to see if there are 4 arguments and maybe the output kind
+    if( argc < 5 || argc > 6 ) {
+        cerr << "Usage: " << argv[0]
+             << " <database> <oracle> <pairs.tsv> <outfile> [d|p]" << endl;
+        return 1;
+    }
+    string kind = argc == 6 ? argv[5] : "d";
+    if( kind != "d" && kind != "p" ) {
+        cerr << "Unknown output " << kind << "!\n";
+        return 1;
+    }
+
+    //build the graph and load or build its oracle
+    ActorGraph actorGraph = ActorGraph();
+    if( !actorGraph.load( argv[1], 0 ) ) { return 1; }
+    if( !actorGraph.loadDistanceOracle( argv[2] ) ) {
+        cerr << "Building the distance oracle " << argv[2] << endl;
+        actorGraph.buildDistanceOracle();
+        if( !actorGraph.saveDistanceOracle( argv[2] ) ) { return 1; }
+    }
+
+    ifstream pairfile(argv[3]);
+    ofstream outfile(argv[4]);
+
+    //print the header to the outfile
+    if( kind == "p" ) {
+        outfile << "(actor)--[movie#@year]-->(actor)--..." << endl;
+    } else {
+        outfile << "Actor1\tActor2\tDistance" << endl;
+    }
+
+    //loop through each pair and print its answer
+    bool header = true;
+    while (pairfile) {
+        string s;
+        // get the next line
+        if (!getline(pairfile, s)) break;
+        if (header){
+            header = false;
+            continue; }
+        istringstream ss(s);
+        vector<string> record;
+        while (ss) {
+            string str;
+            // get the next string before hitting a tab character
+            if (!getline(ss, str, '\t')) break;
+            record.push_back(str);
+        }
+        if (record.size() != 2) {
+            // we should have exactly 2 columns
+            continue;
+        }
+
+        if( kind == "p" ) {
+            outfile << actorGraph.findOraclePath( record[0], record[1] )
+                    << '\n';
+        } else {
+            unsigned int dist =
+                actorGraph.findActorDistance( record[0], record[1] );
+            outfile << record[0] << '\t' << record[1] << '\t'
+                    << (dist == (unsigned)-1 ? -1 : (long)dist) << '\n';
+        }
+
+    }
+
+    pairfile.close();
+    outfile.close();
+    return 0;
+
+}
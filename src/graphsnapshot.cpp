@@ -0,0 +1,35 @@
+/**
+ * This file turns a credit database into a binary snapshot of the actor
+ * graph. pathfinder, linkpredictor and movietraveler accept the snapshot in
+ * place of the database and load it much faster than they can parse the
+ * database, so the snapshot only has to be rebuilt when the database changes.
+ * Author: Christian Kouris
+ * Email: ckouris@ucsd.edu
+ * Sources: loadFromFile implementation
+ */
+
+#include "ActorGraph.hpp"
+#include <iostream>
+
+using namespace std;
+
+/* This is the main driver of the snapshot builder. It takes in the database
+ * file and the name of the snapshot file to write.
+ * Parameter: argc - the number of arguments passed in + the function name
+ * Parameter: argv - the list of arguments that were passed in.
+ */
+int main( int argc, char* argv[] ) {
+
+    //check to see if there are exactly 2 arguments
+    if( argc != 3 ) {
+        cerr << "Usage: " << argv[0] << " <database.tsv> <snapshot>" << endl;
+        return 1;
+    }
+
+    //build the graph from the database and write it back out
+    ActorGraph actorGraph = ActorGraph();
+    if( !actorGraph.loadFromFile( argv[1], 0 ) ) { return 1; }
+    if( !actorGraph.saveSnapshot( argv[2] ) ) { return 1; }
+    return 0;
+
+}
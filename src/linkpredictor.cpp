@@ -33,7 +33,7 @@ int main( int argc, char* argv[] ) {
    
     //build the graph using the first argument passed as the file
     ActorGraph actorGraph = ActorGraph();
-    actorGraph.loadFromFile( argv[1] );
+    actorGraph.load( argv[1], 0 );
     //open up the infile and the two outfiles
     ifstream actorfile(argv[2]);
     ofstream outfilecollab(argv[3]);
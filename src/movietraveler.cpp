@@ -1,42 +1,55 @@
 /**
  * The movietraveler program finds the smallest way to connect all of the
  * actors through their movies. It uses an algorithm called Kruskal's
- * algorithm in order to find the connected graph with the least weight.
+ * algorithm in order to find the connected graph with the least weight, or
+ * Boruvka's algorithm on several threads when it is asked for.
  * Author: Christian Kouris
  * Email: ckouris@ucsd.edu
  * Sources: 
  */
 
 #include "ActorGraph.hpp"
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <string>
 
 using namespace std;
 
-/* 
+/* This is the main driver of the movie traveler. It takes in the database
+ * file, the output file and optionally the algorithm to use, "kruskal" by
+ * default or "boruvka", which runs on all cores unless the number of
+ * threads is given after it. Both print the same trees.
  * Parameter: argc - the number of arguments passed into the command line
  * Parameter: argv - a list of all of the arguments passed in
  */
 int main( int argc, char* argv[] ) {
 
-    if( argc < 3 ) {
+    if( argc < 3 || argc > 5 ) {
         return 0;
     }
+
+    //which algorithm finds the trees
+    string engine = argc >= 4 ? argv[3] : "kruskal";
+    if( engine != "kruskal" && engine != "boruvka" ) {
+        cerr << "Unknown algorithm " << engine << "!\n";
+        return 1;
+    }
+    unsigned int numThreads = argc == 5 ? (unsigned int)atoi( argv[4] ) : 0;
     
     //build the graph using the first argument passed as the file
     ActorGraph actorGraph = ActorGraph();
-    actorGraph.loadFromFile( argv[1] );
+    actorGraph.load( argv[1], 0 );
     //open outfile and put in the header
     ofstream outfile(argv[2]);
-    outfile << "(actor)<--[movie#@year]-->(actor)" << endl;
-
-    //get the vector of strings from ActorGraph
-    vector<string> output = actorGraph.findSmallestTree();
-    for( unsigned int i = 0; i < output.size(); i++ ) {
-
-        outfile << output[i] << endl;
+    outfile << "(actor)<--[movie#@year]-->(actor)" << '\n';
 
+    //the trees are written as they are found and flushed once at the end
+    if( engine == "boruvka" ) {
+        actorGraph.writeSmallestTreeBoruvka( outfile, numThreads );
+    } else {
+        actorGraph.writeSmallestTree( outfile );
     }
 
     outfile.close();
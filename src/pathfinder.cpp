@@ -10,6 +10,7 @@
  */
 
 #include "ActorGraph.hpp"
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -21,15 +22,23 @@ using namespace std;
 
 /* This is the main driver of the path finder. It takes in the database file,
  * wether or not the movies should be weighted by year, the file of the list
- * of the connected actors, and the output file. The program calls either the
- * BFS function or the Dijkstra function from the ActorGraph class.
+ * of the connected actors, the output file and optionally the search to use.
+ * All of the pairs are read first and answered as one batch by the ActorGraph
+ * class, with BFS or Dijkstra by default, the bidirectional BFS or
+ * Dijkstra's search when the search is "bidir", the multi source BFS when
+ * the search is "msbfs" on an unweighted graph, the bucket queue Dijkstra
+ * when the search is "dial" on a weighted graph, the landmark A* search
+ * when the search is "alt" on a weighted graph or the contraction hierarchy
+ * search when the search is "ch" on a weighted graph. Large unweighted
+ * batches use the multi source BFS on their own. The pairs are answered on all
+ * cores unless the number of threads is given after the search.
  * Parameter: argc - the number of arguments passed in + the function name
  * Parameter: argv - the list of arguments that were passed in.
  */
 int main( int argc, char* argv[] ) {
 
-    //check to see if there are exactly 4 arguments
-    if( argc != 5 ) {
+    //check to see if there are 4 arguments and maybe the search and threads
+    if( argc < 5 || argc > 7 ) {
         return 0;
     }
 
@@ -37,9 +46,39 @@ int main( int argc, char* argv[] ) {
     bool isWeighted = false;
     if( *argv[2] == 'w' ) { isWeighted = true; }
 
+    //which search answers the queries
+    string engine = argc >= 6 ? argv[5] : "";
+    PathSearch search = isWeighted ? SEARCH_DIJKSTRA : SEARCH_BFS;
+    bool isKnown = engine.empty() ||
+                   engine == (isWeighted ? "dijkstra" : "bfs");
+    if( engine == "bidir" ) {
+        search = isWeighted ? SEARCH_WEIGHTED_BIDIRECTIONAL
+                            : SEARCH_BIDIRECTIONAL;
+        isKnown = true;
+    } else if( !isWeighted && engine == "msbfs" ) {
+        search = SEARCH_MULTI_SOURCE;
+        isKnown = true;
+    } else if( isWeighted && engine == "dial" ) {
+        search = SEARCH_DIAL;
+        isKnown = true;
+    } else if( isWeighted && engine == "alt" ) {
+        search = SEARCH_ALT;
+        isKnown = true;
+    } else if( isWeighted && engine == "ch" ) {
+        search = SEARCH_HIERARCHY;
+        isKnown = true;
+    }
+    if( !isKnown ) {
+        cerr << "Unknown search " << engine << " for a "
+             << (isWeighted ? "weighted" : "unweighted") << " graph!\n";
+        return 1;
+    }
+
     //create an ActorGraph and populate it with 
     ActorGraph actorGraph = ActorGraph();
-    actorGraph.loadFromFile(argv[1]);
+    actorGraph.load( argv[1], 0 );
+    if( search == SEARCH_ALT ) { actorGraph.buildLandmarks(); }
+    if( search == SEARCH_HIERARCHY ) { actorGraph.buildHierarchy(); }
     
     //Open the pair file for reading and the outfile for writing
     ifstream pairfile(argv[3]);
@@ -48,7 +87,8 @@ int main( int argc, char* argv[] ) {
     //print the header to the outfile
     outfile << "(actor)--[movie#@year]-->(actor)--..." << endl;
 
-    //loop through each line and output the results to outfile
+    //loop through each line and collect the pairs
+    vector<pair<string, string>> queries = std::vector<pair<string, string>>();
     bool header = true;
     while (pairfile) {
         string s;
@@ -70,20 +110,17 @@ int main( int argc, char* argv[] ) {
             continue;
         }
 
-        string actorStart(record[0]);
-        string actorEnd(record[1]);
-       
-        //output the string based on if the graph is weighted or not
-        if( isWeighted ) {
-
-        outfile << actorGraph.findWeightedActors(actorStart, actorEnd) << endl;
+        queries.push_back( pair<string, string>( record[0], record[1] ) );
 
-        } else {
-
-        outfile << actorGraph.findClosestActors(actorStart, actorEnd) << endl;
-
-        }
+    }
 
+    //answer all of the pairs at once on every core unless told otherwise
+    //and output them in order
+    unsigned int numThreads = argc == 7 ? (unsigned int)atoi( argv[6] ) : 0;
+    vector<string> paths = actorGraph.findPaths( queries, search,
+                                                 numThreads );
+    for( unsigned int i = 0; i < paths.size(); i++ ) {
+        outfile << paths[i] << '\n';
     }
 
     pairfile.close();
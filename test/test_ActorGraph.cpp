@@ -1,12 +1,1053 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
 #include "ActorGraph.hpp"
 
 using namespace std;
 using namespace testing;
 
+/* writes the given contents to a file in the test directory and returns
+ * the name of the file */
+static string writeFile( const string& name, const string& contents ) {
+    ofstream out( name );
+    out << contents;
+    out.close();
+    return name;
+}
+
+/* joins both lists of a link prediction into one string to compare */
+static string joinLinks( const pair<vector<string>, vector<string>>& links ) {
+    string joined = "";
+    for( unsigned int i = 0; i < links.first.size(); i++ ) {
+        joined += links.first[i] + "\t";
+    }
+    joined += "\n";
+    for( unsigned int i = 0; i < links.second.size(); i++ ) {
+        joined += links.second[i] + "\t";
+    }
+    return joined;
+}
+
+/* returns the number of movies in a formatted path */
+static unsigned int pathLength( const string& path ) {
+    unsigned int length = 0;
+    for( size_t pos = path.find( "--[" ); pos != string::npos;
+         pos = path.find( "--[", pos + 1 ) ) {
+        length++;
+    }
+    return length;
+}
+
+/* returns the total weight of the movies in a formatted path */
+static unsigned int pathWeight( const string& path ) {
+    unsigned int weight = 0;
+    for( size_t pos = path.find( "#@" ); pos != string::npos;
+         pos = path.find( "#@", pos + 1 ) ) {
+        weight += 1 + 2019 - stoi( path.substr( pos + 2, 4 ) );
+    }
+    return weight;
+}
+
+/* writes a database of numLines credits where every movie has six actors
+ * and returns the name of the file */
+static string writeGeneratedFile( const string& name, unsigned int numLines ) {
+    string contents = "Actor/Actress\tMovie\tYear\n";
+    for( unsigned int i = 0; i < numLines; i++ ) {
+        contents += "Actor " + to_string( (i * 7919) % 20000 ) + "\tMovie " +
+                    to_string( i / 6 ) + "\t" + to_string( 1950 + i % 70 ) +
+                    "\n";
+    }
+    return writeFile( name, contents );
+}
+
 TEST(ACTOR_GRAPH_TESTS, TEST_EMPTY_GRAPH) {
 
     ActorGraph graph = ActorGraph();
     ASSERT_EQ( graph.findClosestActors("a","b"), "" );
 
 }
+
+TEST(ACTOR_GRAPH_TESTS, TEST_LOAD_SKIPS_MALFORMED_LINES) {
+
+    string file = writeFile( "test_load_graph.tsv",
+        "Actor/Actress\tMovie\tYear\n"
+        "Kevin Bacon\tX-Men: First Class\t2011\n"
+        "James McAvoy\tX-Men: First Class\t2011\t\n"
+        "James McAvoy\tGlass\t2019\textra\n"
+        "Broken Line\n"
+        "\n"
+        "Samuel L. Jackson\tGlass\t2019" );
+
+    ActorGraph graph = ActorGraph();
+    ASSERT_TRUE( graph.loadFromFile( file.c_str() ) );
+    ASSERT_EQ( graph.findClosestActors("Kevin Bacon", "James McAvoy"),
+        "(Kevin Bacon)--[X-Men: First Class#@2011]-->(James McAvoy)" );
+    ASSERT_EQ( graph.findClosestActors("Kevin Bacon", "Samuel L. Jackson"),
+               "" );
+    remove( file.c_str() );
+
+}
+
+TEST(ACTOR_GRAPH_TESTS, TEST_LOAD_MISSING_FILE) {
+
+    ActorGraph graph = ActorGraph();
+    ASSERT_FALSE( graph.loadFromFile( "no_such_file.tsv" ) );
+
+}
+
+TEST(ACTOR_GRAPH_TESTS, TEST_PARALLEL_LOAD_MATCHES_SERIAL) {
+
+    //large enough that the file is split into several chunks
+    string file = writeGeneratedFile( "test_parallel_graph.tsv", 120000 );
+
+    ActorGraph serial = ActorGraph();
+    ActorGraph parallel = ActorGraph();
+    ASSERT_TRUE( serial.loadFromFile( file.c_str(), 1 ) );
+    ASSERT_TRUE( parallel.loadFromFile( file.c_str(), 4 ) );
+    for( unsigned int i = 0; i < 20; i++ ) {
+        string start = "Actor " + to_string( i * 97 );
+        string end = "Actor " + to_string( 19999 - i * 31 );
+        ASSERT_EQ( serial.findClosestActors( start, end ),
+                   parallel.findClosestActors( start, end ) );
+        ASSERT_EQ( serial.findWeightedActors( start, end ),
+                   parallel.findWeightedActors( start, end ) );
+    }
+    remove( file.c_str() );
+
+}
+
+TEST(ACTOR_GRAPH_TESTS, TEST_SNAPSHOT_ROUND_TRIP) {
+
+    string file = writeFile( "test_snapshot_graph.tsv",
+        "Actor/Actress\tMovie\tYear\n"
+        "Kevin Bacon\tX-Men: First Class\t2011\n"
+        "James McAvoy\tX-Men: First Class\t2011\n"
+        "James McAvoy\tGlass\t2019\n"
+        "Samuel L. Jackson\tGlass\t2019\n"
+        "Samuel L. Jackson\tGlass\t2000\n" );
+
+    ActorGraph graph = ActorGraph();
+    ASSERT_TRUE( graph.loadFromFile( file.c_str() ) );
+    ASSERT_TRUE( graph.saveSnapshot( "test_snapshot_graph.snap" ) );
+
+    ActorGraph snapshot = ActorGraph();
+    ASSERT_TRUE( snapshot.load( "test_snapshot_graph.snap" ) );
+    ASSERT_EQ( snapshot.findClosestActors("Kevin Bacon", "Samuel L. Jackson"),
+               graph.findClosestActors("Kevin Bacon", "Samuel L. Jackson") );
+    ASSERT_EQ( snapshot.findWeightedActors("Samuel L. Jackson", "Kevin Bacon"),
+               graph.findWeightedActors("Samuel L. Jackson", "Kevin Bacon") );
+    ASSERT_EQ( snapshot.getPredictedLinks("James McAvoy"),
+               graph.getPredictedLinks("James McAvoy") );
+    ASSERT_EQ( snapshot.findClosestActors("Kevin Bacon", "Nobody"), "" );
+    remove( file.c_str() );
+    remove( "test_snapshot_graph.snap" );
+
+    //credits added to the snapshot join the movies it already has, and
+    //its spanning forest is brought up to date with them
+    SpanningForest forest = SpanningForest();
+    snapshot.buildSpanningForest( forest );
+    string delta = writeFile( "test_snapshot_delta.tsv",
+        "Actor/Actress\tMovie\tYear\n"
+        "Kevin Bacon\tGlass\t2019\n"
+        "Tom Hanks\tGlass\t2000\n" );
+    ASSERT_TRUE( graph.loadFromFile( delta.c_str() ) );
+    ASSERT_TRUE( snapshot.loadFromFile( delta.c_str() ) );
+    remove( delta.c_str() );
+    ASSERT_EQ( snapshot.findWeightedActors("Tom Hanks", "Kevin Bacon"),
+               graph.findWeightedActors("Tom Hanks", "Kevin Bacon") );
+    ASSERT_EQ( snapshot.findWeightedActors("Kevin Bacon", "James McAvoy"),
+               "(Kevin Bacon)--[Glass#@2019]-->(James McAvoy)" );
+    ForestChanges changes = snapshot.updateSpanningForest( forest );
+    ASSERT_EQ( changes.added.size(), 2 );
+    ASSERT_EQ( changes.removed.size(), 1 );
+    vector<string> expected = snapshot.findSmallestTree();
+    expected.resize( forest.size() );
+    vector<string> updated = std::vector<string>();
+    for( const ForestEdge& edge : forest.edges() ) {
+        updated.push_back( snapshot.formatEdge( edge ) );
+    }
+    std::sort( expected.begin(), expected.end() );
+    std::sort( updated.begin(), updated.end() );
+    ASSERT_EQ( updated, expected );
+
+}
+
+TEST(ACTOR_GRAPH_TESTS, TEST_SNAPSHOT_KEEPS_NAME_INDEX) {
+
+    string file = writeGeneratedFile( "test_snapshot_index.tsv", 30000 );
+    ActorGraph graph = ActorGraph();
+    ASSERT_TRUE( graph.loadFromFile( file.c_str() ) );
+    remove( file.c_str() );
+    ASSERT_TRUE( graph.saveSnapshot( "test_snapshot_index.snap" ) );
+    ActorGraph snapshot = ActorGraph();
+    ASSERT_TRUE( snapshot.load( "test_snapshot_index.snap" ) );
+    remove( "test_snapshot_index.snap" );
+
+    //every actor is found by the saved index, and no one else is
+    for( unsigned int i = 0; i < 20000; i += 7 ) {
+        string actor = "Actor " + to_string( i );
+        ASSERT_EQ( snapshot.findClosestActors( actor, actor ),
+                   "(" + actor + ")" );
+        ASSERT_EQ( snapshot.findClosestActors( actor, "Actor 0" ),
+                   graph.findClosestActors( actor, "Actor 0" ) );
+    }
+    ASSERT_EQ( snapshot.findClosestActors( "Actor 20000", "Actor 0" ), "" );
+    ASSERT_EQ( snapshot.findClosestActors( "Movie 0", "Actor 0" ), "" );
+
+}
+
+TEST(ACTOR_GRAPH_TESTS, TEST_CONCURRENT_QUERIES) {
+
+    string file = writeGeneratedFile( "test_concurrent_graph.tsv", 30000 );
+    ActorGraph graph = ActorGraph();
+    ASSERT_TRUE( graph.loadFromFile( file.c_str() ) );
+    remove( file.c_str() );
+
+    //answer every query once on this thread as the expected results
+    vector<string> expected = std::vector<string>();
+    for( unsigned int i = 0; i < 40; i++ ) {
+        string start = "Actor " + to_string( i * 13 );
+        string end = "Actor " + to_string( 19999 - i * 7 );
+        expected.push_back( graph.findClosestActors( start, end ) );
+        expected.push_back( graph.findWeightedActors( start, end ) );
+        expected.push_back( joinLinks( graph.getPredictedLinks( start ) ) );
+    }
+
+    //every thread answers all of the queries with its own context
+    vector<vector<string>> results = std::vector<vector<string>>( 4 );
+    vector<thread> workers = std::vector<thread>();
+    for( unsigned int t = 0; t < results.size(); t++ ) {
+        workers.emplace_back( [&graph, &results, t]() {
+            QueryContext context = QueryContext();
+            for( unsigned int i = 0; i < 40; i++ ) {
+                string start = "Actor " + to_string( i * 13 );
+                string end = "Actor " + to_string( 19999 - i * 7 );
+                results[t].push_back(
+                    graph.findClosestActors( start, end, context ) );
+                results[t].push_back(
+                    graph.findWeightedActors( start, end, context ) );
+                results[t].push_back(
+                    joinLinks( graph.getPredictedLinks( start, context ) ) );
+            }
+        } );
+    }
+    for( unsigned int t = 0; t < workers.size(); t++ ) {
+        workers[t].join();
+        ASSERT_EQ( results[t], expected );
+    }
+
+}
+
+TEST(ACTOR_GRAPH_TESTS, TEST_PREDICTED_LINKS_TIE_BREAK) {
+
+    //Alice counts every one of her movies, Dan has two with her, and the
+    //rest have one each, so their names decide their order
+    string file = writeFile( "test_predicted_ties.tsv",
+        "Actor/Actress\tMovie\tYear\n"
+        "Alice\tM1\t2000\n"
+        "Eve\tM1\t2000\n"
+        "Alice\tM2\t2001\n"
+        "Dan\tM2\t2001\n"
+        "Alice\tM3\t2002\n"
+        "Bob\tM3\t2002\n"
+        "Alice\tM4\t2003\n"
+        "Carl\tM4\t2003\n"
+        "Alice\tM5\t2004\n"
+        "Fay\tM5\t2004\n"
+        "Alice\tM6\t2005\n"
+        "Dan\tM6\t2005\n" );
+    ActorGraph graph = ActorGraph();
+    ASSERT_TRUE( graph.loadFromFile( file.c_str() ) );
+    remove( file.c_str() );
+
+    pair<vector<string>, vector<string>> links =
+        graph.getPredictedLinks( "Alice" );
+    ASSERT_EQ( links.first,
+               vector<string>( { "Alice", "Dan", "Bob", "Carl" } ) );
+    ASSERT_TRUE( links.second.empty() );
+    ASSERT_EQ( graph.getPredictedLinks( "Alice", 2 ).first,
+               vector<string>( { "Alice", "Dan" } ) );
+    ASSERT_EQ( graph.getPredictedLinks( "Alice", 10 ).first,
+               vector<string>( { "Alice", "Dan", "Bob", "Carl", "Eve",
+                                 "Fay" } ) );
+
+}
+
+TEST(ACTOR_GRAPH_TESTS, TEST_PREDICTED_LINKS_TOP_K) {
+
+    string file = writeGeneratedFile( "test_predicted_top.tsv", 30000 );
+    ActorGraph graph = ActorGraph();
+    ASSERT_TRUE( graph.loadFromFile( file.c_str() ) );
+    remove( file.c_str() );
+
+    //a big enough k sorts every actor, and a smaller one is its front
+    for( unsigned int i = 0; i < 20; i++ ) {
+        string actor = "Actor " + to_string( i * 97 );
+        pair<vector<string>, vector<string>> all =
+            graph.getPredictedLinks( actor, 100000 );
+        unsigned int sizes[] = { 0, 1, 4, 25 };
+        for( unsigned int k : sizes ) {
+            pair<vector<string>, vector<string>> best =
+                graph.getPredictedLinks( actor, k );
+            ASSERT_EQ( best.first, vector<string>( all.first.begin(),
+                all.first.begin() + min( (size_t)k, all.first.size() ) ) );
+            ASSERT_EQ( best.second, vector<string>( all.second.begin(),
+                all.second.begin() + min( (size_t)k, all.second.size() ) ) );
+        }
+    }
+
+}
+
+TEST(ACTOR_GRAPH_TESTS, TEST_BIDIRECTIONAL_CHAIN) {
+
+    //a chain of five actors where A and E also share a movie
+    string file = writeFile( "test_bidirectional_graph.tsv",
+        "Actor/Actress\tMovie\tYear\n"
+        "A\tM1\t2000\nB\tM1\t2000\nB\tM2\t2001\nC\tM2\t2001\n"
+        "C\tM3\t2002\nD\tM3\t2002\nD\tM4\t2003\nE\tM4\t2003\n"
+        "F\tM5\t2004\nA\tM6\t2005\nE\tM6\t2005\n" );
+    ActorGraph graph = ActorGraph();
+    ASSERT_TRUE( graph.loadFromFile( file.c_str() ) );
+    remove( file.c_str() );
+
+    ASSERT_EQ( graph.findClosestActorsBidirectional( "A", "D" ),
+        "(A)--[M6#@2005]-->(E)--[M4#@2003]-->(D)" );
+    ASSERT_EQ( graph.findClosestActorsBidirectional( "B", "D" ),
+        "(B)--[M2#@2001]-->(C)--[M3#@2002]-->(D)" );
+    ASSERT_EQ( graph.findClosestActorsBidirectional( "C", "C" ), "(C)" );
+    ASSERT_EQ( graph.findClosestActorsBidirectional( "A", "F" ), "" );
+    ASSERT_EQ( graph.findClosestActorsBidirectional( "A", "Nobody" ), "" );
+
+}
+
+TEST(ACTOR_GRAPH_TESTS, TEST_BIDIRECTIONAL_MATCHES_BFS) {
+
+    string file = writeGeneratedFile( "test_bidirectional_graph.tsv", 30000 );
+    ActorGraph graph = ActorGraph();
+    ASSERT_TRUE( graph.loadFromFile( file.c_str() ) );
+    remove( file.c_str() );
+
+    //the paths may differ but they have to be just as short
+    for( unsigned int i = 0; i < 100; i++ ) {
+        string start = "Actor " + to_string( i * 37 );
+        string end = "Actor " + to_string( 19999 - i * 11 );
+        string path = graph.findClosestActors( start, end );
+        string bidirectional =
+            graph.findClosestActorsBidirectional( start, end );
+        ASSERT_EQ( pathLength( bidirectional ), pathLength( path ) );
+        if( path.empty() ) {
+            ASSERT_EQ( bidirectional, "" );
+            continue;
+        }
+        ASSERT_EQ( bidirectional.find( "(" + start + ")" ), 0 );
+        ASSERT_EQ( bidirectional.rfind( "(" + end + ")" ),
+                   bidirectional.size() - end.size() - 2 );
+    }
+
+}
+
+TEST(ACTOR_GRAPH_TESTS, TEST_ACTOR_DISTANCES_CHAIN) {
+
+    //actors are added in the order A, B, C, D, E, F
+    string file = writeFile( "test_distances_graph.tsv",
+        "Actor/Actress\tMovie\tYear\n"
+        "A\tM1\t2000\nB\tM1\t2000\nB\tM2\t2001\nC\tM2\t2001\n"
+        "C\tM3\t2002\nD\tM3\t2002\nD\tM4\t2003\nE\tM4\t2003\n"
+        "F\tM5\t2004\n" );
+    ActorGraph graph = ActorGraph();
+    ASSERT_TRUE( graph.loadFromFile( file.c_str() ) );
+    remove( file.c_str() );
+
+    vector<unsigned int> expected = { 0, 1, 2, 3, 4, (unsigned)-1 };
+    ASSERT_EQ( graph.findActorDistances( "A" ), expected );
+    expected = { 2, 1, 0, 1, 2, (unsigned)-1 };
+    ASSERT_EQ( graph.findActorDistances( "C" ), expected );
+    expected = std::vector<unsigned int>( 6, (unsigned)-1 );
+    ASSERT_EQ( graph.findActorDistances( "Nobody" ), expected );
+
+}
+
+TEST(ACTOR_GRAPH_TESTS, TEST_ACTOR_DISTANCES_MATCH_BFS) {
+
+    //a hub in every tenth movie makes the frontier big enough to go bottom
+    //up, the hub gets id 0 and the actor on line i gets id i + 1
+    string contents = "Actor/Actress\tMovie\tYear\n";
+    for( unsigned int i = 0; i < 20000; i++ ) {
+        if( i % 40 == 0 ) {
+            contents += "Hub\tMovie " + to_string( i / 4 ) + "\t2000\n";
+        }
+        contents += "Actor " + to_string( (i * 7919) % 20000 ) + "\tMovie " +
+                    to_string( i / 4 ) + "\t2000\n";
+    }
+    string file = writeFile( "test_distances_graph.tsv", contents );
+    ActorGraph graph = ActorGraph();
+    ASSERT_TRUE( graph.loadFromFile( file.c_str() ) );
+    remove( file.c_str() );
+
+    QueryContext context = QueryContext();
+    const char* starts[] = { "Hub", "Actor 0", "Actor 12345" };
+    for( unsigned int s = 0; s < 3; s++ ) {
+        vector<unsigned int> actorDist =
+            graph.findActorDistances( starts[s], context );
+        for( unsigned int i = 0; i < 20000; i += 97 ) {
+            string end = "Actor " + to_string( (i * 7919) % 20000 );
+            string path = graph.findClosestActors( starts[s], end, context );
+            unsigned int expected = path.empty() ? (unsigned)-1
+                                                 : pathLength( path );
+            ASSERT_EQ( actorDist[i + 1], expected );
+        }
+    }
+
+}
+
+TEST(ACTOR_GRAPH_TESTS, TEST_DIAL_CHAIN) {
+
+    //the direct movie of A and D is heavier than the chain through B and C,
+    //whose movies from 2020 weigh nothing
+    string file = writeFile( "test_dial_graph.tsv",
+        "Actor/Actress\tMovie\tYear\n"
+        "A\tM1\t2020\nB\tM1\t2020\nB\tM2\t2019\nC\tM2\t2019\n"
+        "C\tM3\t2020\nD\tM3\t2020\nA\tM4\t2015\nD\tM4\t2015\n"
+        "E\tM5\t2000\n" );
+    ActorGraph graph = ActorGraph();
+    ASSERT_TRUE( graph.loadFromFile( file.c_str() ) );
+    remove( file.c_str() );
+
+    string expected = "(A)--[M1#@2020]-->(B)--[M2#@2019]-->(C)--[M3#@2020]"
+                      "-->(D)";
+    ASSERT_EQ( graph.findWeightedActorsDial( "A", "D" ), expected );
+    ASSERT_EQ( graph.findWeightedActors( "A", "D" ), expected );
+    ASSERT_EQ( graph.findWeightedActorsDial( "B", "B" ), "(B)" );
+    ASSERT_EQ( graph.findWeightedActorsDial( "A", "E" ), "" );
+    ASSERT_EQ( graph.findWeightedActorsDial( "A", "Nobody" ), "" );
+
+}
+
+TEST(ACTOR_GRAPH_TESTS, TEST_DIAL_MATCHES_DIJKSTRA) {
+
+    string file = writeGeneratedFile( "test_dial_graph.tsv", 30000 );
+    ActorGraph graph = ActorGraph();
+    ASSERT_TRUE( graph.loadFromFile( file.c_str() ) );
+    remove( file.c_str() );
+
+    //the paths may differ but they have to weigh the same
+    QueryContext context = QueryContext();
+    for( unsigned int i = 0; i < 100; i++ ) {
+        string start = "Actor " + to_string( i * 37 );
+        string end = "Actor " + to_string( 19999 - i * 11 );
+        string path = graph.findWeightedActors( start, end, context );
+        string dial = graph.findWeightedActorsDial( start, end, context );
+        ASSERT_EQ( dial.empty(), path.empty() );
+        ASSERT_EQ( pathWeight( dial ), pathWeight( path ) );
+    }
+
+}
+
+TEST(ACTOR_GRAPH_TESTS, TEST_WEIGHTED_ACTOR_GETS_CLOSER_IN_QUEUE) {
+
+    //E and B are queued from Far and then get closer through Mid and Near
+    //while they are still in the queue
+    string file = writeFile( "test_weighted_closer.tsv",
+        "Actor/Actress\tMovie\tYear\n"
+        "S\tFar\t2016\n" "E\tFar\t2016\n" "B\tFar\t2016\n"
+        "S\tMid\t2018\n" "E\tMid\t2018\n"
+        "B\tFree\t2020\n" "E\tFree\t2020\n"
+        "S\tNear\t2019\n" "B\tNear\t2019\n" );
+    ActorGraph graph = ActorGraph();
+    ASSERT_TRUE( graph.loadFromFile( file.c_str() ) );
+    remove( file.c_str() );
+
+    ASSERT_EQ( graph.findWeightedActors( "S", "E" ),
+               "(S)--[Near#@2019]-->(B)--[Free#@2020]-->(E)" );
+    const char* names[] = { "S", "E", "B" };
+    for( const char* start : names ) {
+        for( const char* end : names ) {
+            string path = graph.findWeightedActors( start, end );
+            string dial = graph.findWeightedActorsDial( start, end );
+            ASSERT_EQ( pathWeight( path ), pathWeight( dial ) );
+        }
+    }
+
+}
+
+TEST(ACTOR_GRAPH_TESTS, TEST_ALT_MATCHES_DIAL) {
+
+    string file = writeGeneratedFile( "test_alt_graph.tsv", 30000 );
+    ActorGraph graph = ActorGraph();
+    ASSERT_TRUE( graph.loadFromFile( file.c_str() ) );
+    remove( file.c_str() );
+
+    //without landmarks the search is still exact, just unguided
+    vector<pair<string, string>> queries =
+        std::vector<pair<string, string>>();
+    QueryContext context = QueryContext();
+    for( unsigned int i = 0; i < 100; i++ ) {
+        string start = "Actor " + to_string( i * 37 );
+        string end = "Actor " + to_string( 19999 - i * 11 );
+        queries.push_back( pair<string, string>( start, end ) );
+        string dial = graph.findWeightedActorsDial( start, end, context );
+        string alt = graph.findWeightedActorsALT( start, end, context );
+        ASSERT_EQ( alt.empty(), dial.empty() );
+        ASSERT_EQ( pathWeight( alt ), pathWeight( dial ) );
+    }
+
+    graph.buildLandmarks( 4 );
+    vector<string> paths = graph.findPaths( queries, SEARCH_ALT, 2u );
+    for( unsigned int i = 0; i < queries.size(); i++ ) {
+        string dial = graph.findWeightedActorsDial( queries[i].first,
+                                                    queries[i].second );
+        string alt = graph.findWeightedActorsALT( queries[i].first,
+                                                  queries[i].second );
+        ASSERT_EQ( paths[i], alt );
+        ASSERT_EQ( alt.empty(), dial.empty() );
+        ASSERT_EQ( pathWeight( alt ), pathWeight( dial ) );
+        if( alt.empty() ) { continue; }
+        ASSERT_EQ( alt.find( "(" + queries[i].first + ")" ), 0 );
+    }
+
+}
+
+TEST(ACTOR_GRAPH_TESTS, TEST_ALT_SEPARATE_GROUPS) {
+
+    //the old movie is lighter to avoid than to take
+    string file = writeFile( "test_alt_groups.tsv",
+        "Actor/Actress\tMovie\tYear\n"
+        "A\tOld\t1950\n" "D\tOld\t1950\n"
+        "A\tM1\t2019\n" "B\tM1\t2019\n"
+        "B\tM2\t2019\n" "C\tM2\t2019\n"
+        "C\tM3\t2019\n" "D\tM3\t2019\n"
+        "E\tM4\t2000\n" "F\tM4\t2000\n" );
+    ActorGraph graph = ActorGraph();
+    ASSERT_TRUE( graph.loadFromFile( file.c_str() ) );
+    remove( file.c_str() );
+    graph.buildLandmarks( 3 );
+
+    ASSERT_EQ( graph.findWeightedActorsALT( "A", "D" ),
+               "(A)--[M1#@2019]-->(B)--[M2#@2019]-->(C)--[M3#@2019]-->(D)" );
+    ASSERT_EQ( graph.findWeightedActorsALT( "E", "F" ),
+               "(E)--[M4#@2000]-->(F)" );
+    ASSERT_EQ( graph.findWeightedActorsALT( "A", "F" ), "" );
+    ASSERT_EQ( graph.findWeightedActorsALT( "F", "C" ), "" );
+    ASSERT_EQ( graph.findWeightedActorsALT( "C", "C" ), "(C)" );
+
+}
+
+TEST(ACTOR_GRAPH_TESTS, TEST_HIERARCHY_MATCHES_DIAL) {
+
+    string file = writeGeneratedFile( "test_hierarchy_graph.tsv", 30000 );
+    ActorGraph graph = ActorGraph();
+    ASSERT_TRUE( graph.loadFromFile( file.c_str() ) );
+    remove( file.c_str() );
+    graph.buildHierarchy();
+
+    vector<pair<string, string>> queries =
+        std::vector<pair<string, string>>();
+    for( unsigned int i = 0; i < 200; i++ ) {
+        queries.push_back( pair<string, string>(
+            "Actor " + to_string( i * 37 ),
+            "Actor " + to_string( 19999 - i * 11 ) ) );
+    }
+    queries.push_back( pair<string, string>( "Actor 37", "Actor 37" ) );
+    vector<string> paths = graph.findPaths( queries, SEARCH_HIERARCHY, 2u );
+    for( unsigned int i = 0; i < queries.size(); i++ ) {
+        string dial = graph.findWeightedActorsDial( queries[i].first,
+                                                    queries[i].second );
+        ASSERT_EQ( paths[i].empty(), dial.empty() );
+        ASSERT_EQ( pathWeight( paths[i] ), pathWeight( dial ) );
+        if( dial.empty() ) { continue; }
+        ASSERT_EQ( paths[i].find( "(" + queries[i].first + ")" ), 0 );
+        ASSERT_EQ( paths[i].rfind( "(" + queries[i].second + ")" ),
+                   paths[i].size() - queries[i].second.size() - 2 );
+    }
+    ASSERT_EQ( paths.back(), "(Actor 37)" );
+
+}
+
+TEST(ACTOR_GRAPH_TESTS, TEST_HIERARCHY_UNPACKS_PATHS) {
+
+    //the old movie is lighter to avoid than to take
+    string file = writeFile( "test_hierarchy_chain.tsv",
+        "Actor/Actress\tMovie\tYear\n"
+        "A\tOld\t1950\n" "D\tOld\t1950\n"
+        "A\tM1\t2019\n" "B\tM1\t2019\n"
+        "B\tM2\t2018\n" "C\tM2\t2018\n"
+        "C\tM3\t2017\n" "D\tM3\t2017\n"
+        "E\tM4\t2000\n" "F\tM4\t2000\n" );
+    ActorGraph graph = ActorGraph();
+    ASSERT_TRUE( graph.loadFromFile( file.c_str() ) );
+    remove( file.c_str() );
+    graph.buildHierarchy();
+
+    ASSERT_EQ( graph.findWeightedActorsCH( "A", "D" ),
+               "(A)--[M1#@2019]-->(B)--[M2#@2018]-->(C)--[M3#@2017]-->(D)" );
+    ASSERT_EQ( graph.findWeightedActorsCH( "D", "A" ),
+               "(D)--[M3#@2017]-->(C)--[M2#@2018]-->(B)--[M1#@2019]-->(A)" );
+    ASSERT_EQ( graph.findWeightedActorsCH( "F", "E" ),
+               "(F)--[M4#@2000]-->(E)" );
+    ASSERT_EQ( graph.findWeightedActorsCH( "A", "F" ), "" );
+    ASSERT_EQ( graph.findWeightedActorsCH( "A", "Nobody" ), "" );
+
+}
+
+TEST(ACTOR_GRAPH_TESTS, TEST_WEIGHTED_BIDIRECTIONAL_MATCHES_DIAL) {
+
+    string file = writeGeneratedFile( "test_wbidir_graph.tsv", 30000 );
+    ActorGraph graph = ActorGraph();
+    ASSERT_TRUE( graph.loadFromFile( file.c_str() ) );
+    remove( file.c_str() );
+
+    vector<pair<string, string>> queries =
+        std::vector<pair<string, string>>();
+    for( unsigned int i = 0; i < 100; i++ ) {
+        queries.push_back( pair<string, string>(
+            "Actor " + to_string( i * 41 ),
+            "Actor " + to_string( 19999 - i * 13 ) ) );
+    }
+    vector<string> paths =
+        graph.findPaths( queries, SEARCH_WEIGHTED_BIDIRECTIONAL, 2u );
+    for( unsigned int i = 0; i < queries.size(); i++ ) {
+        string dial = graph.findWeightedActorsDial( queries[i].first,
+                                                    queries[i].second );
+        string bidir = graph.findWeightedActorsBidirectional(
+            queries[i].first, queries[i].second );
+        ASSERT_EQ( paths[i], bidir );
+        ASSERT_EQ( bidir.empty(), dial.empty() );
+        ASSERT_EQ( pathWeight( bidir ), pathWeight( dial ) );
+        if( bidir.empty() ) { continue; }
+        ASSERT_EQ( bidir.find( "(" + queries[i].first + ")" ), 0 );
+        string end = "(" + queries[i].second + ")";
+        ASSERT_EQ( bidir.rfind( end ), bidir.size() - end.size() );
+    }
+
+}
+
+TEST(ACTOR_GRAPH_TESTS, TEST_WEIGHTED_BIDIRECTIONAL_CHAIN) {
+
+    //the old movie is lighter to avoid than to take
+    string file = writeFile( "test_wbidir_chain.tsv",
+        "Actor/Actress\tMovie\tYear\n"
+        "A\tOld\t1950\n" "D\tOld\t1950\n"
+        "A\tM1\t2019\n" "B\tM1\t2019\n"
+        "B\tM2\t2019\n" "C\tM2\t2019\n"
+        "C\tM3\t2019\n" "D\tM3\t2019\n"
+        "E\tM4\t2000\n" "F\tM4\t2000\n" );
+    ActorGraph graph = ActorGraph();
+    ASSERT_TRUE( graph.loadFromFile( file.c_str() ) );
+    remove( file.c_str() );
+
+    ASSERT_EQ( graph.findWeightedActorsBidirectional( "A", "D" ),
+               "(A)--[M1#@2019]-->(B)--[M2#@2019]-->(C)--[M3#@2019]-->(D)" );
+    ASSERT_EQ( graph.findWeightedActorsBidirectional( "D", "B" ),
+               "(D)--[M3#@2019]-->(C)--[M2#@2019]-->(B)" );
+    ASSERT_EQ( graph.findWeightedActorsBidirectional( "E", "F" ),
+               "(E)--[M4#@2000]-->(F)" );
+    ASSERT_EQ( graph.findWeightedActorsBidirectional( "A", "F" ), "" );
+    ASSERT_EQ( graph.findWeightedActorsBidirectional( "C", "C" ), "(C)" );
+    ASSERT_EQ( graph.findWeightedActorsBidirectional( "A", "Nobody" ), "" );
+
+}
+
+TEST(ACTOR_GRAPH_TESTS, TEST_WEIGHTED_BIDIRECTIONAL_FREE_MOVIE) {
+
+    //a 2020 movie weighs nothing, so the start side can check every actor
+    //it reaches before the end side has checked anything
+    string file = writeFile( "test_wbidir_free.tsv",
+        "Actor/Actress\tMovie\tYear\n"
+        "A\tZero\t2020\n" "B\tZero\t2020\n"
+        "C\tFree1\t2020\n" "D\tFree1\t2020\n"
+        "D\tFree2\t2020\n" "E\tFree2\t2020\n"
+        "E\tM1\t2019\n" "F\tM1\t2019\n" );
+    ActorGraph graph = ActorGraph();
+    ASSERT_TRUE( graph.loadFromFile( file.c_str() ) );
+    remove( file.c_str() );
+
+    ASSERT_EQ( graph.findWeightedActorsBidirectional( "A", "B" ),
+               "(A)--[Zero#@2020]-->(B)" );
+    ASSERT_EQ( graph.findWeightedActorsBidirectional( "B", "A" ),
+               "(B)--[Zero#@2020]-->(A)" );
+    ASSERT_EQ( graph.findWeightedActorsBidirectional( "C", "E" ),
+               "(C)--[Free1#@2020]-->(D)--[Free2#@2020]-->(E)" );
+    ASSERT_EQ( graph.findWeightedActorsBidirectional( "C", "F" ),
+               "(C)--[Free1#@2020]-->(D)--[Free2#@2020]-->(E)--[M1#@2019]"
+               "-->(F)" );
+    ASSERT_EQ( graph.findWeightedActorsBidirectional( "A", "F" ), "" );
+
+}
+
+TEST(ACTOR_GRAPH_TESTS, TEST_BATCH_MATCHES_SINGLE_QUERIES) {
+
+    string file = writeGeneratedFile( "test_batch_graph.tsv", 30000 );
+    ActorGraph graph = ActorGraph();
+    ASSERT_TRUE( graph.loadFromFile( file.c_str() ) );
+    remove( file.c_str() );
+
+    //a few starting actors with many ends each, repeated ends, a start that
+    //is its own end and actors that are not in the graph
+    vector<pair<string, string>> queries = 
+        std::vector<pair<string, string>>();
+    for( unsigned int i = 0; i < 200; i++ ) {
+        queries.push_back( pair<string, string>(
+            "Actor " + to_string( (i % 5) * 101 ),
+            "Actor " + to_string( (i * 7717) % 2000 ) ) );
+    }
+    queries.push_back( pair<string, string>( "Actor 101", "Actor 101" ) );
+    queries.push_back( pair<string, string>( "Actor 101", "Nobody" ) );
+    queries.push_back( pair<string, string>( "Nobody", "Actor 101" ) );
+
+    QueryContext context = QueryContext();
+    vector<string> paths = graph.findPaths( queries, SEARCH_BFS );
+    vector<string> weighted = graph.findPaths( queries, SEARCH_DIJKSTRA );
+    vector<string> dial = graph.findPaths( queries, SEARCH_DIAL, context );
+    ASSERT_EQ( paths.size(), queries.size() );
+    for( unsigned int i = 0; i < queries.size(); i++ ) {
+        const string& start = queries[i].first;
+        const string& end = queries[i].second;
+        ASSERT_EQ( paths[i], graph.findClosestActors( start, end ) );
+        ASSERT_EQ( weighted[i], graph.findWeightedActors( start, end ) );
+        ASSERT_EQ( dial[i], graph.findWeightedActorsDial( start, end ) );
+    }
+    ASSERT_EQ( paths[200], "(Actor 101)" );
+    ASSERT_EQ( paths[201], "" );
+    ASSERT_EQ( paths[202], "" );
+
+}
+
+TEST(ACTOR_GRAPH_TESTS, TEST_THREADED_BATCH_KEEPS_ORDER) {
+
+    string file = writeGeneratedFile( "test_threaded_graph.tsv", 30000 );
+    ActorGraph graph = ActorGraph();
+    ASSERT_TRUE( graph.loadFromFile( file.c_str() ) );
+    remove( file.c_str() );
+
+    vector<pair<string, string>> queries = 
+        std::vector<pair<string, string>>();
+    for( unsigned int i = 0; i < 300; i++ ) {
+        queries.push_back( pair<string, string>(
+            "Actor " + to_string( (i % 23) * 353 ),
+            "Actor " + to_string( (i * 7717) % 20000 ) ) );
+    }
+
+    PathSearch searches[] = { SEARCH_BFS, SEARCH_BIDIRECTIONAL,
+                              SEARCH_DIJKSTRA, SEARCH_DIAL };
+    for( unsigned int s = 0; s < 4; s++ ) {
+        vector<string> expected = graph.findPaths( queries, searches[s] );
+        ASSERT_EQ( graph.findPaths( queries, searches[s], 4u ), expected );
+        ASSERT_EQ( graph.findPaths( queries, searches[s], 1u ), expected );
+    }
+
+}
+
+TEST(ACTOR_GRAPH_TESTS, TEST_MULTI_SOURCE_MATCHES_BFS_LENGTH) {
+
+    string file = writeGeneratedFile( "test_multi_source_graph.tsv", 30000 );
+    ActorGraph graph = ActorGraph();
+    ASSERT_TRUE( graph.loadFromFile( file.c_str() ) );
+    remove( file.c_str() );
+
+    //more than 64 starting actors so there are several multi source
+    //searches, and some queries that start where they end
+    vector<pair<string, string>> queries = 
+        std::vector<pair<string, string>>();
+    for( unsigned int i = 0; i < 1500; i++ ) {
+        queries.push_back( pair<string, string>(
+            "Actor " + to_string( (i % 150) * 131 ),
+            "Actor " + to_string( (i * 7717) % 20000 ) ) );
+    }
+    queries.push_back( pair<string, string>( "Actor 131", "Actor 131" ) );
+    queries.push_back( pair<string, string>( "Actor 131", "Nobody" ) );
+
+    vector<string> paths = graph.findPaths( queries, SEARCH_MULTI_SOURCE );
+    vector<string> automatic = graph.findPaths( queries, SEARCH_BFS, 2u );
+    ASSERT_EQ( automatic, paths );
+    for( unsigned int i = 0; i < queries.size(); i++ ) {
+        string expected = graph.findClosestActors( queries[i].first,
+                                                   queries[i].second );
+        ASSERT_EQ( pathLength( paths[i] ), pathLength( expected ) );
+        ASSERT_EQ( paths[i].empty(), expected.empty() );
+        if( expected.empty() ) { continue; }
+        ASSERT_EQ( paths[i].find( "(" + queries[i].first + ")" ), 0 );
+        ASSERT_EQ( paths[i].rfind( "(" + queries[i].second + ")" ),
+                   paths[i].size() - queries[i].second.size() - 2 );
+    }
+    ASSERT_EQ( paths[1500], "(Actor 131)" );
+    ASSERT_EQ( paths[1501], "" );
+
+}
+
+TEST(ACTOR_GRAPH_TESTS, TEST_ORACLE_MATCHES_BFS) {
+
+    string file = writeGeneratedFile( "test_oracle_graph.tsv", 30000 );
+    ActorGraph graph = ActorGraph();
+    ASSERT_TRUE( graph.loadFromFile( file.c_str() ) );
+    remove( file.c_str() );
+
+    //nothing can be answered before the oracle is built
+    ASSERT_EQ( graph.findActorDistance( "Actor 0", "Actor 1" ), (unsigned)-1 );
+    ASSERT_FALSE( graph.saveDistanceOracle( "test_oracle_graph.oracle" ) );
+    graph.buildDistanceOracle();
+
+    for( unsigned int i = 0; i < 400; i++ ) {
+        string actorStart = "Actor " + to_string( (i * 131) % 20000 );
+        string actorEnd = "Actor " + to_string( (i * 7717) % 20000 );
+        string expected = graph.findClosestActors( actorStart, actorEnd );
+        unsigned int dist = graph.findActorDistance( actorStart, actorEnd );
+        string path = graph.findOraclePath( actorStart, actorEnd );
+        if( expected.empty() ) {
+            ASSERT_EQ( dist, (unsigned)-1 );
+            ASSERT_EQ( path, "" );
+            continue;
+        }
+        ASSERT_EQ( dist, pathLength( expected ) );
+        ASSERT_EQ( pathLength( path ), dist );
+        ASSERT_EQ( path.find( "(" + actorStart + ")" ), 0 );
+        ASSERT_EQ( path.rfind( "(" + actorEnd + ")" ),
+                   path.size() - actorEnd.size() - 2 );
+    }
+    ASSERT_EQ( graph.findActorDistance( "Actor 131", "Actor 131" ), 0 );
+    ASSERT_EQ( graph.findOraclePath( "Actor 131", "Actor 131" ),
+               "(Actor 131)" );
+    ASSERT_EQ( graph.findActorDistance( "Actor 131", "Nobody" ),
+               (unsigned)-1 );
+
+}
+
+TEST(ACTOR_GRAPH_TESTS, TEST_ORACLE_ROUND_TRIP) {
+
+    string file = writeFile( "test_oracle_chain.tsv",
+        "Actor/Actress\tMovie\tYear\n"
+        "A\tM1\t2000\n" "B\tM1\t2000\n"
+        "B\tM2\t2001\n" "C\tM2\t2001\n"
+        "C\tM3\t2002\n" "D\tM3\t2002\n"
+        "E\tM4\t2003\n" "F\tM4\t2003\n" );
+    ActorGraph graph = ActorGraph();
+    ASSERT_TRUE( graph.loadFromFile( file.c_str() ) );
+    graph.buildDistanceOracle();
+    ASSERT_TRUE( graph.saveDistanceOracle( "test_oracle_chain.oracle" ) );
+
+    ActorGraph loaded = ActorGraph();
+    ASSERT_TRUE( loaded.loadFromFile( file.c_str() ) );
+    ASSERT_TRUE( loaded.loadDistanceOracle( "test_oracle_chain.oracle" ) );
+    ASSERT_EQ( loaded.findActorDistance( "A", "D" ), 3 );
+    ASSERT_EQ( loaded.findActorDistance( "D", "B" ), 2 );
+    ASSERT_EQ( loaded.findActorDistance( "A", "F" ), (unsigned)-1 );
+    ASSERT_EQ( loaded.findOraclePath( "A", "C" ),
+               "(A)--[M1#@2000]-->(B)--[M2#@2001]-->(C)" );
+    remove( file.c_str() );
+
+    //an oracle is never loaded for a different graph
+    string other = writeFile( "test_oracle_other.tsv",
+        "Actor/Actress\tMovie\tYear\n"
+        "A\tM1\t2000\n" "B\tM1\t2000\n" );
+    ActorGraph different = ActorGraph();
+    ASSERT_TRUE( different.loadFromFile( other.c_str() ) );
+    ASSERT_FALSE( different.loadDistanceOracle( "test_oracle_chain.oracle" ) );
+    ASSERT_FALSE( different.loadDistanceOracle( other.c_str() ) );
+    remove( other.c_str() );
+    remove( "test_oracle_chain.oracle" );
+
+}
+
+TEST(ACTOR_GRAPH_TESTS, TEST_SMALLEST_TREE_LIGHTEST_MOVIES) {
+
+    string file = writeFile( "test_tree_triangle.tsv",
+        "Actor/Actress\tMovie\tYear\n"
+        "A\tM1\t2000\n" "B\tM1\t2000\n" "C\tM1\t2000\n"
+        "A\tM2\t2018\n" "B\tM2\t2018\n"
+        "B\tM3\t2015\n" "C\tM3\t2015\n" );
+    ActorGraph graph = ActorGraph();
+    ASSERT_TRUE( graph.loadFromFile( file.c_str() ) );
+    remove( file.c_str() );
+
+    ASSERT_EQ( graph.findSmallestTree(), vector<string>( {
+        "(A)<--[M2#@2018]-->(B)",
+        "(B)<--[M3#@2015]-->(C)",
+        "#NODE CONNECTED: 3",
+        "#EDGE CHOSEN: 2",
+        "TOTAL EDGE WEIGHTS: 7" } ) );
+
+}
+
+TEST(ACTOR_GRAPH_TESTS, TEST_SMALLEST_TREE_FOREST) {
+
+    //three groups of actors that never worked together
+    string file = writeFile( "test_tree_forest.tsv",
+        "Actor/Actress\tMovie\tYear\n"
+        "A\tM1\t2000\n" "B\tM1\t2000\n" "C\tM1\t2000\n"
+        "D\tM2\t2010\n" "E\tM2\t2010\n"
+        "F\tM3\t2019\n" );
+    ActorGraph graph = ActorGraph();
+    ASSERT_TRUE( graph.loadFromFile( file.c_str() ) );
+    remove( file.c_str() );
+
+    ASSERT_EQ( graph.findSmallestTree(), vector<string>( {
+        "(D)<--[M2#@2010]-->(E)",
+        "(A)<--[M1#@2000]-->(B)",
+        "(A)<--[M1#@2000]-->(C)",
+        "#NODE CONNECTED: 6",
+        "#TREES IN FOREST: 3",
+        "#EDGE CHOSEN: 3",
+        "TOTAL EDGE WEIGHTS: 50" } ) );
+
+    ActorGraph empty = ActorGraph();
+    ASSERT_EQ( empty.findSmallestTree(), vector<string>( {
+        "#NODE CONNECTED: 0",
+        "#EDGE CHOSEN: 0",
+        "TOTAL EDGE WEIGHTS: 0" } ) );
+
+}
+
+TEST(ACTOR_GRAPH_TESTS, TEST_BORUVKA_MATCHES_KRUSKAL) {
+
+    string file = writeGeneratedFile( "test_tree_boruvka.tsv", 30000 );
+    ActorGraph graph = ActorGraph();
+    ASSERT_TRUE( graph.loadFromFile( file.c_str() ) );
+    remove( file.c_str() );
+
+    vector<string> expected = graph.findSmallestTree();
+    unsigned int threads[] = { 1, 2, 3, 8 };
+    for( unsigned int numThreads : threads ) {
+        ASSERT_EQ( graph.findSmallestTreeBoruvka( numThreads ), expected );
+    }
+
+    //a forest and an empty graph come out the same way too
+    string forest = writeFile( "test_tree_boruvka_forest.tsv",
+        "Actor/Actress\tMovie\tYear\n"
+        "A\tM1\t2000\n" "B\tM1\t2000\n" "C\tM1\t2000\n"
+        "D\tM2\t2010\n" "E\tM2\t2010\n"
+        "B\tM3\t2000\n" "C\tM3\t2000\n"
+        "F\tM4\t2019\n" );
+    ActorGraph forestGraph = ActorGraph();
+    ASSERT_TRUE( forestGraph.loadFromFile( forest.c_str() ) );
+    remove( forest.c_str() );
+    ASSERT_EQ( forestGraph.findSmallestTreeBoruvka( 2 ),
+               forestGraph.findSmallestTree() );
+    ActorGraph empty = ActorGraph();
+    ASSERT_EQ( empty.findSmallestTreeBoruvka( 4 ), empty.findSmallestTree() );
+
+}
+
+TEST(ACTOR_GRAPH_TESTS, TEST_SPANNING_FOREST_UPDATE) {
+
+    //movies of six actors, each with a single year
+    string contents = "Actor/Actress\tMovie\tYear\n";
+    for( unsigned int i = 0; i < 30000; i++ ) {
+        contents += "Actor " + to_string( (i * 7919) % 20000 ) + "\tMovie " +
+                    to_string( i / 6 ) + "\t" +
+                    to_string( 1950 + (i / 6) % 70 ) + "\n";
+    }
+    string file = writeFile( "test_forest_base.tsv", contents );
+    ActorGraph graph = ActorGraph();
+    ASSERT_TRUE( graph.loadFromFile( file.c_str() ) );
+    remove( file.c_str() );
+    SpanningForest forest = SpanningForest();
+    graph.buildSpanningForest( forest );
+    vector<ForestEdge> oldEdges = forest.edges();
+
+    //newer, lighter movies between old and new actors, and a few more
+    //actors for movies that are already in the graph
+    contents = "Actor/Actress\tMovie\tYear\n";
+    for( unsigned int i = 0; i < 600; i++ ) {
+        contents += "Actor " + to_string( (i * 4957) % 20000 ) +
+                    "\tNew Movie " + to_string( i / 4 ) + "\t" +
+                    to_string( 1990 + (i / 4) % 30 ) + "\n";
+    }
+    for( unsigned int i = 0; i < 40; i++ ) {
+        contents += "Actor " + to_string( 20000 + i % 20 ) + "\tMovie " +
+                    to_string( i * 7 ) + "\t" +
+                    to_string( 1950 + (i * 7) % 70 ) + "\n";
+    }
+    string delta = writeFile( "test_forest_delta.tsv", contents );
+    ASSERT_TRUE( graph.loadFromFile( delta.c_str() ) );
+    remove( delta.c_str() );
+
+    ForestChanges changes = graph.updateSpanningForest( forest );
+    ASSERT_FALSE( changes.added.empty() );
+    ASSERT_FALSE( changes.removed.empty() );
+
+    //the updated forest is the one built from scratch
+    vector<string> expected = graph.findSmallestTree();
+    expected.resize( forest.size() );
+    vector<string> updated = std::vector<string>();
+    for( const ForestEdge& edge : forest.edges() ) {
+        updated.push_back( graph.formatEdge( edge ) );
+    }
+    std::sort( expected.begin(), expected.end() );
+    std::sort( updated.begin(), updated.end() );
+    ASSERT_EQ( updated, expected );
+
+    //and the changes are exactly what it takes to get there
+    vector<string> applied = std::vector<string>();
+    for( const ForestEdge& edge : oldEdges ) {
+        if( std::find( changes.removed.begin(), changes.removed.end(),
+                       edge ) == changes.removed.end() ) {
+            applied.push_back( graph.formatEdge( edge ) );
+        }
+    }
+    for( const ForestEdge& edge : changes.added ) {
+        ASSERT_EQ( std::find( oldEdges.begin(), oldEdges.end(), edge ),
+                   oldEdges.end() );
+        applied.push_back( graph.formatEdge( edge ) );
+    }
+    std::sort( applied.begin(), applied.end() );
+    ASSERT_EQ( applied, updated );
+
+    //nothing new means nothing changes
+    ForestChanges none = graph.updateSpanningForest( forest );
+    ASSERT_TRUE( none.added.empty() );
+    ASSERT_TRUE( none.removed.empty() );
+
+    //two loads before one update, both adding to the same movie
+    string first = writeFile( "test_forest_first.tsv",
+        "Actor/Actress\tMovie\tYear\n"
+        "Actor 3\tLate Movie\t2019\n" "Actor 4\tLate Movie\t2019\n" );
+    string second = writeFile( "test_forest_second.tsv",
+        "Actor/Actress\tMovie\tYear\n"
+        "Actor 5\tLate Movie\t2019\n" "Actor 20100\tMovie 0\t1950\n" );
+    ASSERT_TRUE( graph.loadFromFile( first.c_str() ) );
+    ASSERT_TRUE( graph.loadFromFile( second.c_str() ) );
+    remove( first.c_str() );
+    remove( second.c_str() );
+    ASSERT_EQ( graph.updateSpanningForest( forest ).added.size(), 3 );
+    expected = graph.findSmallestTree();
+    expected.resize( forest.size() );
+    updated.clear();
+    for( const ForestEdge& edge : forest.edges() ) {
+        updated.push_back( graph.formatEdge( edge ) );
+    }
+    std::sort( expected.begin(), expected.end() );
+    std::sort( updated.begin(), updated.end() );
+    ASSERT_EQ( updated, expected );
+
+}
+
+TEST(ACTOR_GRAPH_TESTS, TEST_WRITE_SMALLEST_TREE) {
+
+    string file = writeGeneratedFile( "test_tree_write.tsv", 30000 );
+    ActorGraph graph = ActorGraph();
+    ASSERT_TRUE( graph.loadFromFile( file.c_str() ) );
+    remove( file.c_str() );
+
+    //the streamed lines are the lines findSmallestTree returns
+    string expected = "";
+    vector<string> lines = graph.findSmallestTree();
+    for( unsigned int i = 0; i < lines.size(); i++ ) {
+        expected += lines[i] + "\n";
+    }
+    ostringstream kruskal;
+    graph.writeSmallestTree( kruskal );
+    ASSERT_EQ( kruskal.str(), expected );
+    ostringstream boruvka;
+    graph.writeSmallestTreeBoruvka( boruvka, 2 );
+    ASSERT_EQ( boruvka.str(), expected );
+
+    ActorGraph empty = ActorGraph();
+    ostringstream none;
+    empty.writeSmallestTree( none );
+    ASSERT_EQ( none.str(),
+        "#NODE CONNECTED: 0\n#EDGE CHOSEN: 0\nTOTAL EDGE WEIGHTS: 0\n" );
+
+}
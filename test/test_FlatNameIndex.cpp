@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "FlatNameIndex.hpp"
+
+using namespace std;
+using namespace testing;
+
+TEST(FLAT_NAME_INDEX_TESTS, TEST_FINDS_EVERY_NAME_AFTER_GROWING) {
+
+    vector<string> names = std::vector<string>();
+    for( unsigned int i = 0; i < 50000; i++ ) {
+        names.push_back( "Actor " + to_string( i ) );
+    }
+    FlatNameIndex index = FlatNameIndex();
+    for( uint32_t i = 0; i < names.size(); i++ ) {
+        index.insert( FlatNameIndex::hash( names[i] ), i );
+    }
+    ASSERT_EQ( index.size(), names.size() );
+    ASSERT_LE( index.size() * 2, index.slots.size() );
+
+    for( uint32_t i = 0; i < names.size(); i++ ) {
+        string_view name = names[i];
+        ASSERT_EQ( index.find( FlatNameIndex::hash( name ),
+            [&]( uint32_t id ) { return names[id] == name; } ), i );
+    }
+    string_view missing = "Actor 50000";
+    ASSERT_EQ( index.find( FlatNameIndex::hash( missing ),
+        [&]( uint32_t id ) { return names[id] == missing; } ),
+        FlatNameIndex::NOT_FOUND );
+
+}
+
+TEST(FLAT_NAME_INDEX_TESTS, TEST_SAME_HASH_DIFFERENT_NAMES) {
+
+    //every name gets the same hash, so only equals can tell them apart
+    vector<string> names = { "A", "B", "C", "D" };
+    FlatNameIndex index = FlatNameIndex();
+    for( uint32_t i = 0; i < names.size(); i++ ) {
+        index.insert( 7, i );
+    }
+    for( uint32_t i = 0; i < names.size(); i++ ) {
+        ASSERT_EQ( index.find( 7,
+            [&]( uint32_t id ) { return names[id] == names[i]; } ), i );
+    }
+    ASSERT_EQ( index.find( 7, []( uint32_t ) { return false; } ),
+               FlatNameIndex::NOT_FOUND );
+    ASSERT_EQ( index.find( 8, []( uint32_t ) { return true; } ),
+               FlatNameIndex::NOT_FOUND );
+
+    //the year seed keeps remakes apart
+    ASSERT_NE( FlatNameIndex::hash( "Glass", 2019 ),
+               FlatNameIndex::hash( "Glass", 2000 ) );
+
+}
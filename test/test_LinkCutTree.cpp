@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+#include "LinkCutTree.hpp"
+
+using namespace std;
+using namespace testing;
+
+/* finds the path between two nodes of a forest given by its edges and
+ * returns the node with the largest key on it, or -1 if there is none */
+static int naiveLargest( const vector<vector<uint32_t>>& edges,
+                         const vector<int>& keys, uint32_t from, uint32_t to ) {
+    vector<int> previous = std::vector<int>( edges.size(), -2 );
+    vector<uint32_t> queue = std::vector<uint32_t>( 1, from );
+    previous[from] = -1;
+    for( size_t i = 0; i < queue.size(); i++ ) {
+        for( uint32_t next : edges[queue[i]] ) {
+            if( previous[next] == -2 ) {
+                previous[next] = queue[i];
+                queue.push_back( next );
+            }
+        }
+    }
+    if( previous[to] == -2 ) { return -1; }
+    int best = to;
+    for( int cur = to; cur != -1; cur = previous[cur] ) {
+        if( keys[cur] > keys[best] ) { best = cur; }
+    }
+    return best;
+}
+
+TEST(LINK_CUT_TREE_TESTS, TEST_PATH_LARGEST) {
+
+    //a path 0 - 1 - 2 - 3 and a lone node 4
+    LinkCutTree<int> tree = LinkCutTree<int>();
+    int keys[] = { 5, 9, 1, 7, 3 };
+    for( int key : keys ) { tree.add( key ); }
+    tree.link( 0, 1 );
+    tree.link( 2, 1 );
+    tree.link( 3, 2 );
+    ASSERT_TRUE( tree.connected( 0, 3 ) );
+    ASSERT_FALSE( tree.connected( 0, 4 ) );
+    ASSERT_EQ( tree.pathLargest( 0, 3 ), 1 );
+    ASSERT_EQ( tree.pathLargest( 2, 3 ), 3 );
+    ASSERT_EQ( tree.pathLargest( 3, 3 ), 3 );
+
+    tree.cut( 1, 2 );
+    ASSERT_FALSE( tree.connected( 0, 3 ) );
+    ASSERT_EQ( tree.pathLargest( 3, 2 ), 3 );
+    tree.link( 4, 3 );
+    tree.link( 4, 0 );
+    ASSERT_EQ( tree.pathLargest( 1, 2 ), 1 );
+    ASSERT_EQ( tree.pathLargest( 2, 4 ), 3 );
+
+}
+
+TEST(LINK_CUT_TREE_TESTS, TEST_MATCHES_NAIVE_FOREST) {
+
+    const uint32_t numNodes = 300;
+    LinkCutTree<int> tree = LinkCutTree<int>();
+    vector<int> keys = std::vector<int>();
+    vector<vector<uint32_t>> edges =
+        std::vector<vector<uint32_t>>( numNodes );
+    vector<pair<uint32_t, uint32_t>> edgeList =
+        std::vector<pair<uint32_t, uint32_t>>();
+    uint32_t seed = 4321;
+    auto next = [&seed]() {
+        seed = seed * 1103515245 + 12345;
+        return seed >> 8;
+    };
+    for( uint32_t i = 0; i < numNodes; i++ ) {
+        keys.push_back( (int)( next() % 100000 ) );
+        tree.add( keys.back() );
+    }
+
+    for( unsigned int step = 0; step < 5000; step++ ) {
+        uint32_t a = next() % numNodes;
+        uint32_t b = next() % numNodes;
+        int largest = naiveLargest( edges, keys, a, b );
+        ASSERT_EQ( tree.connected( a, b ), largest != -1 );
+        if( largest != -1 ) {
+            ASSERT_EQ( keys[tree.pathLargest( a, b )], keys[largest] );
+        }
+
+        //join two trees, or sometimes split one at a random edge
+        if( largest == -1 ) {
+            tree.link( a, b );
+            edges[a].push_back( b );
+            edges[b].push_back( a );
+            edgeList.push_back( pair<uint32_t, uint32_t>( a, b ) );
+        } else if( !edgeList.empty() && next() % 3 == 0 ) {
+            size_t i = next() % edgeList.size();
+            pair<uint32_t, uint32_t> edge = edgeList[i];
+            edgeList[i] = edgeList.back();
+            edgeList.pop_back();
+            tree.cut( edge.second, edge.first );
+            for( int side = 0; side < 2; side++ ) {
+                uint32_t from = side ? edge.second : edge.first;
+                uint32_t to = side ? edge.first : edge.second;
+                for( size_t j = 0; j < edges[from].size(); j++ ) {
+                    if( edges[from][j] == to ) {
+                        edges[from][j] = edges[from].back();
+                        edges[from].pop_back();
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+}
@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "ActorNode.hpp"
+#include "NodeArena.hpp"
+
+using namespace std;
+using namespace testing;
+
+TEST(NODE_ARENA_TESTS, TEST_NODES_KEEP_THEIR_ADDRESS) {
+
+    //enough nodes to fill a few blocks
+    NodeArena<ActorNode> arena = NodeArena<ActorNode>();
+    vector<string> names = std::vector<string>();
+    for( unsigned int i = 0; i < 5000; i++ ) {
+        names.push_back( "Actor " + to_string( i ) );
+    }
+    vector<ActorNode*> nodes = std::vector<ActorNode*>();
+    for( unsigned int i = 0; i < 5000; i++ ) {
+        nodes.push_back( arena.create( names[i], i ) );
+    }
+    ASSERT_EQ( arena.size(), 5000 );
+    for( unsigned int i = 0; i < nodes.size(); i++ ) {
+        ASSERT_EQ( nodes[i]->name, "Actor " + to_string( i ) );
+        ASSERT_EQ( nodes[i]->id, i );
+    }
+    //the first block is filled in order
+    ASSERT_EQ( nodes[1], nodes[0] + 1 );
+
+    arena.clear();
+    ASSERT_EQ( arena.size(), 0 );
+    ASSERT_EQ( arena.create( "Again" )->name, "Again" );
+
+}
+
+TEST(NODE_ARENA_TESTS, TEST_RESERVE_KEEPS_NODES_TOGETHER) {
+
+    NodeArena<ActorNode> arena = NodeArena<ActorNode>();
+    arena.create( "First" );
+    arena.reserve( 100000 );
+    ActorNode* first = arena.create( "Actor", 0 );
+    for( unsigned int i = 1; i < 100000; i++ ) {
+        ASSERT_EQ( arena.create( "Actor", i ), first + i );
+    }
+    ASSERT_EQ( arena.size(), 100001 );
+
+}
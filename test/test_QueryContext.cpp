@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include "QueryContext.hpp"
+
+using namespace std;
+using namespace testing;
+
+TEST(QUERY_CONTEXT_TESTS, TEST_NEW_SEARCH_FORGETS_OLD_ONE) {
+
+    QueryContext context = QueryContext();
+    context.begin( 3, 2 );
+    context.seeActor( 1 );
+    context.actorDist[1] = 5;
+    context.actorLinks[1] = 2;
+    context.checkActor( 1 );
+    context.checkMovie( 0, 1 );
+    ASSERT_TRUE( context.isActorSeen( 1 ) );
+    ASSERT_EQ( context.dist( 1 ), 5 );
+    ASSERT_EQ( context.links( 1 ), 2 );
+    ASSERT_FALSE( context.isActorSeen( 0 ) );
+    ASSERT_EQ( context.dist( 0 ), (unsigned)-1 );
+
+    context.begin( 3, 2 );
+    ASSERT_FALSE( context.isActorSeen( 1 ) );
+    ASSERT_FALSE( context.isActorChecked( 1 ) );
+    ASSERT_FALSE( context.isMovieChecked( 0 ) );
+    ASSERT_EQ( context.dist( 1 ), (unsigned)-1 );
+    ASSERT_EQ( context.links( 1 ), 0 );
+
+}
+
+TEST(QUERY_CONTEXT_TESTS, TEST_GROWS_WITH_GRAPH) {
+
+    QueryContext context = QueryContext();
+    context.begin( 1, 1 );
+    context.seeActor( 0 );
+    context.begin( 4, 3 );
+    for( uint32_t i = 0; i < 4; i++ ) {
+        ASSERT_FALSE( context.isActorSeen( i ) );
+    }
+    ASSERT_FALSE( context.isMovieChecked( 2 ) );
+
+}
+
+TEST(QUERY_CONTEXT_TESTS, TEST_EPOCH_WRAPS_AROUND) {
+
+    QueryContext context = QueryContext();
+    context.begin( 2, 2 );
+    //jump to the last epoch before the counter wraps
+    context.epoch = (uint32_t)-1;
+    context.seeActor( 0 );
+    context.checkActor( 0 );
+    context.checkMovie( 1, 0 );
+
+    context.begin( 2, 2 );
+    ASSERT_EQ( context.epoch, 1 );
+    ASSERT_FALSE( context.isActorSeen( 0 ) );
+    ASSERT_FALSE( context.isActorChecked( 0 ) );
+    ASSERT_FALSE( context.isMovieChecked( 1 ) );
+
+}
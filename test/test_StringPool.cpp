@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "StringPool.hpp"
+
+using namespace std;
+using namespace testing;
+
+TEST(STRING_POOL_TESTS, TEST_VIEWS_OUTLIVE_THEIR_SOURCE) {
+
+    //enough names to fill a few blocks
+    StringPool pool = StringPool();
+    vector<string_view> views = std::vector<string_view>();
+    size_t bytes = 0;
+    for( unsigned int i = 0; i < 200000; i++ ) {
+        string name = "Actor " + to_string( i );
+        views.push_back( pool.add( name ) );
+        bytes += name.size();
+    }
+    ASSERT_EQ( pool.size(), bytes );
+    for( unsigned int i = 0; i < views.size(); i++ ) {
+        ASSERT_EQ( views[i], "Actor " + to_string( i ) );
+    }
+    //names added one after another sit next to each other
+    ASSERT_EQ( views[1].data(), views[0].data() + views[0].size() );
+
+}
+
+TEST(STRING_POOL_TESTS, TEST_LONG_AND_EMPTY_STRINGS) {
+
+    StringPool pool = StringPool();
+    string_view empty = pool.add( "" );
+    ASSERT_TRUE( empty.empty() );
+    string longName = string( StringPool::BLOCK_BYTES + 10, 'x' );
+    string_view first = pool.add( "First" );
+    string_view copy = pool.add( longName );
+    string_view last = pool.add( "Last" );
+    ASSERT_EQ( first, "First" );
+    ASSERT_EQ( copy, longName );
+    ASSERT_EQ( last, "Last" );
+    ASSERT_EQ( pool.size(), longName.size() + 9 );
+
+    pool.clear();
+    ASSERT_EQ( pool.size(), 0 );
+    ASSERT_EQ( pool.add( "Again" ), "Again" );
+
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "UnionFind.hpp"
+
+using namespace std;
+using namespace testing;
+
+TEST(UNION_FIND_TESTS, TEST_UNITE_AND_COUNT) {
+
+    UnionFind unionFind = UnionFind( 6 );
+    ASSERT_EQ( unionFind.count(), 6 );
+    ASSERT_FALSE( unionFind.connected( 0, 1 ) );
+
+    ASSERT_TRUE( unionFind.unite( 0, 1 ) );
+    ASSERT_TRUE( unionFind.unite( 2, 3 ) );
+    ASSERT_TRUE( unionFind.unite( 1, 3 ) );
+    ASSERT_EQ( unionFind.count(), 3 );
+    //ids that are already together do not change anything
+    ASSERT_FALSE( unionFind.unite( 0, 2 ) );
+    ASSERT_EQ( unionFind.count(), 3 );
+
+    ASSERT_TRUE( unionFind.connected( 0, 3 ) );
+    ASSERT_FALSE( unionFind.connected( 0, 4 ) );
+    ASSERT_EQ( unionFind.size( 2 ), 4 );
+    ASSERT_EQ( unionFind.size( 5 ), 1 );
+    ASSERT_EQ( unionFind.find( 0 ), unionFind.find( 3 ) );
+
+}
+
+TEST(UNION_FIND_TESTS, TEST_SMALLER_SET_GOES_UNDER_BIGGER) {
+
+    UnionFind unionFind = UnionFind( 5 );
+    unionFind.unite( 1, 2 );
+    unionFind.unite( 1, 3 );
+    uint32_t root = unionFind.find( 1 );
+    //uniting from the single id keeps the root of the bigger set
+    unionFind.unite( 4, 2 );
+    ASSERT_EQ( unionFind.find( 4 ), root );
+    unionFind.unite( 0, 4 );
+    ASSERT_EQ( unionFind.find( 0 ), root );
+    ASSERT_EQ( unionFind.size( 0 ), 5 );
+    ASSERT_EQ( unionFind.count(), 1 );
+
+}
+
+TEST(UNION_FIND_TESTS, TEST_MATCHES_LABELS) {
+
+    //every id keeps a label of its set that is relabeled on every unite
+    const uint32_t numIds = 2000;
+    UnionFind unionFind = UnionFind( numIds );
+    vector<uint32_t> labels = std::vector<uint32_t>( numIds );
+    for( uint32_t i = 0; i < numIds; i++ ) { labels[i] = i; }
+    uint32_t numLabels = numIds;
+
+    uint32_t seed = 12345;
+    for( unsigned int step = 0; step < 3000; step++ ) {
+        seed = seed * 1103515245 + 12345;
+        uint32_t a = (seed >> 8) % numIds;
+        seed = seed * 1103515245 + 12345;
+        uint32_t b = (seed >> 8) % numIds;
+
+        bool different = labels[a] != labels[b];
+        ASSERT_EQ( unionFind.unite( a, b ), different );
+        if( different ) {
+            uint32_t oldLabel = labels[b];
+            for( uint32_t i = 0; i < numIds; i++ ) {
+                if( labels[i] == oldLabel ) { labels[i] = labels[a]; }
+            }
+            numLabels--;
+        }
+        ASSERT_EQ( unionFind.count(), numLabels );
+    }
+
+    for( uint32_t i = 0; i < numIds; i += 13 ) {
+        for( uint32_t j = 0; j < numIds; j += 17 ) {
+            ASSERT_EQ( unionFind.connected( i, j ), labels[i] == labels[j] );
+        }
+    }
+
+}